@@ -0,0 +1,87 @@
+#include "arena.h"
+#include <cstdlib>  // For std::malloc, std::free
+#include <cstring>  // For std::memcmp, std::memcpy, std::strlen
+#include <cstdint>  // For uintptr_t
+#include <new>      // For std::bad_alloc
+#include <ostream>
+
+static const size_t MAX_BLOCK_SIZE = 64 * 1024 * 1024; // Growth stops here; larger requests get a block of their own
+
+// --- StringRef ---
+bool StringRef::operator==(const char* other) const {
+    size_t other_len = std::strlen(other);
+    return other_len == size && (size == 0 || std::memcmp(data, other, size) == 0);
+}
+
+bool StringRef::operator==(const std::string& other) const {
+    return other.size() == size && (size == 0 || std::memcmp(data, other.data(), size) == 0);
+}
+
+std::ostream& operator<<(std::ostream& out, const StringRef& ref) {
+    return out.write(ref.data, static_cast<std::streamsize>(ref.size));
+}
+
+// --- MonotonicArena ---
+MonotonicArena::MonotonicArena(size_t first_block_size)
+    : head_(nullptr), cursor_(nullptr), limit_(nullptr),
+      first_block_size_(first_block_size > 0 ? first_block_size : 1), next_block_size_(first_block_size_) {}
+
+MonotonicArena::~MonotonicArena() {
+    release();
+}
+
+void MonotonicArena::add_block(size_t min_bytes) {
+    size_t size = next_block_size_ > min_bytes ? next_block_size_ : min_bytes;
+    Block* block = static_cast<Block*>(std::malloc(sizeof(Block) + size));
+    if (!block) throw std::bad_alloc();
+    block->next = head_;
+    block->size = size;
+    head_ = block;
+    cursor_ = reinterpret_cast<char*>(block + 1);
+    limit_ = cursor_ + size;
+    stats_.blocks++;
+    stats_.block_mallocs++;
+    stats_.bytes_reserved += size;
+    if (next_block_size_ < MAX_BLOCK_SIZE) {
+        next_block_size_ = next_block_size_ * 2 < MAX_BLOCK_SIZE ? next_block_size_ * 2 : MAX_BLOCK_SIZE;
+    }
+}
+
+void* MonotonicArena::allocate(size_t bytes, size_t alignment) {
+    uintptr_t mask = static_cast<uintptr_t>(alignment - 1);
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(cursor_) + mask) & ~mask;
+    if (!head_ || aligned > reinterpret_cast<uintptr_t>(limit_) ||
+        bytes > static_cast<size_t>(reinterpret_cast<uintptr_t>(limit_) - aligned)) {
+        add_block(bytes + alignment - 1);
+        aligned = (reinterpret_cast<uintptr_t>(cursor_) + mask) & ~mask;
+    }
+    cursor_ = reinterpret_cast<char*>(aligned) + bytes;
+    stats_.allocations++;
+    stats_.bytes_used += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+StringRef MonotonicArena::copy(const char* text, size_t length) {
+    if (length == 0) return StringRef();
+    char* bytes = static_cast<char*>(allocate(length));
+    std::memcpy(bytes, text, length);
+    return StringRef(bytes, length);
+}
+
+void MonotonicArena::release() {
+    if (!head_) return;
+    while (head_) {
+        Block* older = head_->next;
+        std::free(head_);
+        head_ = older;
+    }
+    // Size the next first block for a refill of the same data.
+    next_block_size_ = stats_.bytes_used > first_block_size_ ? stats_.bytes_used : first_block_size_;
+    if (next_block_size_ > MAX_BLOCK_SIZE) next_block_size_ = MAX_BLOCK_SIZE;
+    cursor_ = limit_ = nullptr;
+    stats_.allocations = 0;
+    stats_.bytes_used = 0;
+    stats_.bytes_reserved = 0;
+    stats_.blocks = 0;
+    stats_.releases++;
+}
@@ -0,0 +1,77 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <string>
+#include <cstddef>
+#include <iosfwd>
+
+// Non-owning reference to bytes owned elsewhere: a MonotonicArena, a
+// CardStore's text or a mapped file. Default-constructed it is empty.
+struct StringRef {
+    const char* data;
+    size_t size;
+
+    StringRef() : data(""), size(0) {}
+    StringRef(const char* text, size_t length) : data(text), size(length) {}
+
+    std::string str() const { return std::string(data, size); }
+    bool empty() const { return size == 0; }
+    bool operator==(const char* other) const;
+    bool operator==(const std::string& other) const;
+};
+std::ostream& operator<<(std::ostream& out, const StringRef& ref);
+
+// Counters for one arena. `allocations` counts allocate() calls, `block_mallocs`
+// the malloc calls behind them over the arena's lifetime, so the two together
+// show how many heap allocations a load avoided.
+struct ArenaStats {
+    size_t allocations;    // Since the last release()
+    size_t bytes_used;     // Since the last release()
+    size_t bytes_reserved; // Held in blocks right now
+    size_t blocks;         // Held right now
+    size_t block_mallocs;  // Lifetime total
+    size_t releases;       // Lifetime total
+
+    ArenaStats() : allocations(0), bytes_used(0), bytes_reserved(0), blocks(0), block_mallocs(0), releases(0) {}
+};
+
+// --- Monotonic arena ---
+// Hands out memory from large blocks and never frees individual allocations;
+// release() returns every block in one go. Meant for the bytes of a store
+// that is loaded in bulk and dropped in bulk (tasks, notes): a load costs a
+// few block mallocs instead of one or more per field, and teardown is a
+// handful of frees. Bytes of records removed before the next release() stay
+// allocated until then. After a release the first block is sized to what the
+// previous fill used, so a reload of the same data usually takes one malloc.
+class MonotonicArena {
+public:
+    explicit MonotonicArena(size_t first_block_size = 64 * 1024);
+    ~MonotonicArena();
+
+    // `alignment` must be a power of two. Throws std::bad_alloc if out of memory.
+    void* allocate(size_t bytes, size_t alignment = 1);
+    StringRef copy(const char* text, size_t length);
+    StringRef copy(const std::string& text) { return copy(text.data(), text.size()); }
+    void release();
+
+    const ArenaStats& stats() const { return stats_; }
+
+private:
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    struct Block {
+        Block* next; // Older block
+        size_t size; // Usable bytes after the header
+    };
+    void add_block(size_t min_bytes);
+
+    Block* head_;      // Block being filled; older blocks chain off it
+    char* cursor_;     // Next free byte in head_
+    char* limit_;      // End of head_
+    size_t first_block_size_;
+    size_t next_block_size_;
+    ArenaStats stats_;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,79 @@
+#include "atomic_file.h"
+#include <cstdio>   // For std::rename, std::remove
+#include <iostream> // For std::cerr
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #define ISKAALAMAN_HAVE_POSIX_IO 1
+#else
+    #include <fstream>
+#endif
+
+void sync_parent_directory(const std::string& path) {
+#ifdef ISKAALAMAN_HAVE_POSIX_IO
+    std::string::size_type slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+bool write_file_atomically(const std::string& path, const std::string& contents) {
+    const std::string temp_path = path + ".tmp";
+#ifdef ISKAALAMAN_HAVE_POSIX_IO
+    int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Error: Could not open " << temp_path << " for writing." << std::endl;
+        return false;
+    }
+    const char* data = contents.data();
+    size_t remaining = contents.size();
+    while (remaining > 0) { // One write normally suffices; loop for short writes and EINTR
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    bool ok = remaining == 0 && ::fsync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    if (!ok || std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Could not save " << path << "; the previous version was kept." << std::endl;
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    sync_parent_directory(path);
+    return true;
+#else
+    {
+        std::ofstream outfile(temp_path.c_str(), std::ios::binary | std::ios::trunc);
+        if (!outfile) {
+            std::cerr << "Error: Could not open " << temp_path << " for writing." << std::endl;
+            return false;
+        }
+        outfile.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        outfile.flush();
+        if (!outfile) {
+            std::cerr << "Error: Could not save " << path << "; the previous version was kept." << std::endl;
+            outfile.close();
+            std::remove(temp_path.c_str());
+            return false;
+        }
+    }
+    std::remove(path.c_str()); // std::rename does not replace an existing file on every platform
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Could not replace " << path << "." << std::endl;
+        return false;
+    }
+    return true;
+#endif
+}
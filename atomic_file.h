@@ -0,0 +1,16 @@
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <string>
+
+// --- Crash-safe whole-file replacement ---
+// Writes `contents` to "<path>.tmp" with as few write() calls as the OS allows,
+// fsyncs it, then renames it over `path`. A crash at any point leaves either
+// the old file or the complete new one, never a truncated mix.
+// Returns false (and leaves `path` untouched) if any step fails. Without POSIX
+// I/O the old file is removed just before the rename, so there is a brief window.
+bool write_file_atomically(const std::string& path, const std::string& contents);
+// Flushes the directory entry of `path` so a rename or newly created file survives a crash. No-op without POSIX I/O.
+void sync_parent_directory(const std::string& path);
+
+#endif // ATOMIC_FILE_H
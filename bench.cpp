@@ -0,0 +1,349 @@
+// --- ISKAALAMAN benchmark suite ---
+// Generates each store at a chosen scale (bench_generators.h), then times the
+// hot paths of libiskaalaman_core and prints one row per benchmark as JSON or CSV.
+//
+//   iskaalaman_bench [--scale N] [--repeat R] [--seed S] [--format json|csv]
+//                    [--dir DIR] [--generate-only]
+//
+// --scale is the record count of every store (classes, tasks, cards, notes).
+// The .dat files are written to and read from DIR (default bench_data), which
+// is left behind so the generated data can be inspected or reused;
+// --generate-only stops after writing them. Each benchmark runs R times after
+// untimed setup; min, median and mean wall time are reported, along with the
+// heap allocations per run (operator new calls, counted by the replacement
+// below, which only this binary links) and the process's peak RSS so far.
+#include "scheduler_core.h"
+#include "study_core.h"
+#include "file_handler.h"
+#include "term_calendar.h"
+#include "timetable_solver.h"
+#include "bench_generators.h"
+#include "card_queue.h"
+#include "utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/stat.h>     // For mkdir
+    #include <sys/resource.h> // For getrusage
+    #include <unistd.h>       // For chdir
+    #define ISKAALAMAN_BENCH_HAVE_CHDIR 1
+#endif
+
+// --- Allocation counting ---
+// Every operator new in the process goes through here, so a benchmark's count
+// covers the core library and the standard containers it uses.
+static std::atomic<size_t> heapAllocations(0);
+
+void* operator new(std::size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* memory = std::malloc(size ? size : 1);
+    if (!memory) throw std::bad_alloc();
+    return memory;
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+
+// High-water mark of the resident set in KiB, or 0 where it is not available.
+static long peakRssKb() {
+#ifdef ISKAALAMAN_BENCH_HAVE_CHDIR
+    struct rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024; // Bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+struct BenchResult {
+    std::string name;
+    size_t items;              // Records or operations processed per run
+    std::vector<double> runsNs;
+    size_t allocations;        // operator new calls, summed over the timed runs
+    long peakRssKb;            // Process high-water mark after the last run
+};
+
+static volatile size_t benchSink = 0; // Results are folded in here so the work can't be optimized away
+
+static BenchResult runBenchmark(const std::string& name, size_t items, int repeat,
+                                const std::function<void()>& setup, const std::function<void()>& body) {
+    BenchResult result;
+    result.name = name;
+    result.items = items;
+    result.allocations = 0;
+    for (int r = 0; r < repeat; ++r) {
+        if (setup) setup();
+        size_t allocationsBefore = heapAllocations.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto stop = std::chrono::steady_clock::now();
+        result.allocations += heapAllocations.load(std::memory_order_relaxed) - allocationsBefore;
+        result.runsNs.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    result.peakRssKb = peakRssKb();
+    std::cerr << "  " << name << " done" << std::endl;
+    return result;
+}
+
+static void summarize(const BenchResult& result, double& minNs, double& medianNs, double& meanNs) {
+    std::vector<double> runs = result.runsNs;
+    std::sort(runs.begin(), runs.end());
+    minNs = runs.front();
+    medianNs = runs.size() % 2 ? runs[runs.size() / 2] : (runs[runs.size() / 2 - 1] + runs[runs.size() / 2]) / 2;
+    meanNs = 0;
+    for (size_t i = 0; i < runs.size(); ++i) meanNs += runs[i];
+    meanNs /= runs.size();
+}
+
+static std::string formatNumber(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.1f", value);
+    return buffer;
+}
+
+static void printJson(const std::vector<BenchResult>& results, size_t scale, int repeat, unsigned seed) {
+    std::cout << "{\n  \"suite\": \"iskaalaman\",\n"
+              << "  \"scale\": " << scale << ",\n  \"repeat\": " << repeat << ",\n  \"seed\": " << seed << ",\n"
+#ifdef __OPTIMIZE__
+              << "  \"optimized\": true,\n"
+#else
+              << "  \"optimized\": false,\n"
+#endif
+#ifdef __VERSION__
+              << "  \"compiler\": \"" << __VERSION__ << "\",\n"
+#endif
+              << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        double minNs, medianNs, meanNs;
+        summarize(results[i], minNs, medianNs, meanNs);
+        std::cout << "    {\"name\": \"" << results[i].name << "\", \"items\": " << results[i].items
+                  << ", \"min_ns\": " << formatNumber(minNs) << ", \"median_ns\": " << formatNumber(medianNs)
+                  << ", \"mean_ns\": " << formatNumber(meanNs)
+                  << ", \"ns_per_item\": " << formatNumber(results[i].items ? medianNs / results[i].items : medianNs)
+                  << ", \"allocs_per_run\": " << results[i].allocations / results[i].runsNs.size()
+                  << ", \"peak_rss_kb\": " << results[i].peakRssKb
+                  << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    std::cout << "  ],\n";
+    // Arenas as the last load left them (scheduler_core.h, study_core.h)
+    const MonotonicArena* arenas[] = {&tasksArena, &notebooks_arena};
+    const char* arenaNames[] = {"tasks", "notebooks"};
+    std::cout << "  \"arenas\": {\n";
+    for (int a = 0; a < 2; ++a) {
+        const ArenaStats& stats = arenas[a]->stats();
+        std::cout << "    \"" << arenaNames[a] << "\": {\"allocations\": " << stats.allocations
+                  << ", \"bytes_used\": " << stats.bytes_used << ", \"bytes_reserved\": " << stats.bytes_reserved
+                  << ", \"blocks\": " << stats.blocks << ", \"block_mallocs\": " << stats.block_mallocs
+                  << ", \"releases\": " << stats.releases << "}" << (a == 0 ? "," : "") << "\n";
+    }
+    std::cout << "  }\n}" << std::endl;
+}
+
+static void printCsv(const std::vector<BenchResult>& results) {
+    std::cout << "name,items,min_ns,median_ns,mean_ns,ns_per_item,allocs_per_run,peak_rss_kb\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        double minNs, medianNs, meanNs;
+        summarize(results[i], minNs, medianNs, meanNs);
+        std::cout << results[i].name << "," << results[i].items << "," << formatNumber(minNs) << ","
+                  << formatNumber(medianNs) << "," << formatNumber(meanNs) << ","
+                  << formatNumber(results[i].items ? medianNs / results[i].items : medianNs) << ","
+                  << results[i].allocations / results[i].runsNs.size() << "," << results[i].peakRssKb << "\n";
+    }
+    std::cout.flush();
+}
+
+static void markAllDirty() {
+    for (auto& deck : flashcard_decks) deck.dirty = true;
+    for (auto& notebook : notebooks) notebook.dirty = true;
+}
+
+int main(int argc, char* argv[]) {
+    size_t scale = 10000;
+    int repeat = 3;
+    unsigned seed = 42;
+    std::string format = "json";
+    std::string dir = "bench_data";
+    bool generateOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--scale" && hasValue) scale = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--repeat" && hasValue) repeat = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--seed" && hasValue) seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--format" && hasValue) format = argv[++i];
+        else if (arg == "--dir" && hasValue) dir = argv[++i];
+        else if (arg == "--generate-only") generateOnly = true;
+        else {
+            std::cerr << "Usage: iskaalaman_bench [--scale N] [--repeat R] [--seed S] [--format json|csv] [--dir DIR] [--generate-only]" << std::endl;
+            return 2;
+        }
+    }
+    if (scale == 0 || (format != "json" && format != "csv")) {
+        std::cerr << "Error: --scale must be positive and --format json or csv." << std::endl;
+        return 2;
+    }
+#ifdef ISKAALAMAN_BENCH_HAVE_CHDIR
+    ::mkdir(dir.c_str(), 0755); // Fine if it already exists
+    if (::chdir(dir.c_str()) != 0) {
+        std::cerr << "Error: Could not enter " << dir << "." << std::endl;
+        return 1;
+    }
+#endif
+
+    // Generate every store and write it out once; the save benchmarks below rewrite the same files.
+    std::cerr << "Generating " << scale << " records per store..." << std::endl;
+    generate_class_schedule(scale, seed);
+    generate_tasks(scale, seed + 1);
+    generate_flashcards(scale, 50, seed + 2);
+    generate_notebooks(scale, 25, seed + 3);
+    saveClassScheduleToFile();
+    saveTasksToFile();
+    save_flashcards_to_file();
+    save_notebooks_to_file();
+    if (generateOnly) return 0;
+
+    std::vector<BenchResult> results;
+    std::function<void()> noSetup;
+
+    // --- Persistence ---
+    results.push_back(runBenchmark("save_schedule", classSchedule.size(), repeat, noSetup, [] { saveClassScheduleToFile(); }));
+    results.push_back(runBenchmark("load_schedule", classSchedule.size(), repeat, noSetup, [] { loadClassScheduleFromFile(); }));
+    results.push_back(runBenchmark("save_tasks", tasks.size(), repeat, noSetup, [] { saveTasksToFile(); }));
+    results.push_back(runBenchmark("load_tasks", tasks.size(), repeat, noSetup, [] { loadTasksFromFile(); }));
+    results.push_back(runBenchmark("save_flashcards", scale, repeat, markAllDirty, [] { save_flashcards_to_file(); }));
+    results.push_back(runBenchmark("save_flashcards_cached", scale, repeat, noSetup, [] { save_flashcards_to_file(); }));
+    results.push_back(runBenchmark("load_flashcards", scale, repeat, noSetup, [] { load_flashcards_from_file(); }));
+    results.push_back(runBenchmark("save_notebooks", scale, repeat, markAllDirty, [] { save_notebooks_to_file(); }));
+    results.push_back(runBenchmark("load_notebooks", scale, repeat, noSetup, [] { load_notebooks_from_file(); }));
+
+    // --- Scheduler queries ---
+    std::mt19937 rng(seed);
+    const size_t probeCount = std::min<size_t>(scale, 100000);
+    std::vector<ClassDetails> probes(probeCount);
+    for (size_t i = 0; i < probeCount; ++i) {
+        probes[i].dayMask = static_cast<unsigned char>(1u << (rng() % 7));
+        probes[i].startMinutes = 7 * 60 + static_cast<int>(rng() % 600);
+        probes[i].endMinutes = probes[i].startMinutes + 50;
+    }
+    results.push_back(runBenchmark("class_conflict_check", probeCount, repeat, noSetup, [&probes] {
+        for (size_t i = 0; i < probes.size(); ++i) benchSink += classConflictIndex.findConflicts(probes[i]).size();
+    }));
+    // A term with a holiday every other week and a make-up Saturday in between
+    termCalendar.clear();
+    termCalendar.firstDay = CivilDate::today().plusDays(-30).weekStart();
+    termCalendar.lastDay = termCalendar.firstDay.plusDays(53 * 7 - 1);
+    for (int week = 0; week < 53; week += 2) {
+        termCalendar.setHoliday(termCalendar.firstDay.plusDays(week * 7 + 2), "Holiday");
+        termCalendar.setMakeUpDay(termCalendar.firstDay.plusDays(week * 7 + 5), 3);
+    }
+    results.push_back(runBenchmark("class_occurrences_week", 53, repeat, noSetup, [] {
+        // What the week agenda walks, for every week of the term
+        ClassOccurrence occurrence;
+        for (int week = 0; week < 53; ++week) {
+            CivilDate monday = termCalendar.firstDay.plusDays(week * 7);
+            ClassOccurrenceCursor cursor(termCalendar, classConflictIndex, monday, monday.plusDays(6));
+            while (cursor.next(occurrence)) benchSink += occurrence.classIndex;
+        }
+    }));
+    results.push_back(runBenchmark("task_index_rebuild", tasks.size(), repeat, noSetup, [] { rebuildTaskPriorityIndex(); }));
+    results.push_back(runBenchmark("task_priority_list", tasks.size(), repeat, noSetup, [] {
+        benchSink += taskPriorityIndex.pendingByPriority().size(); // What showTasks lists
+    }));
+    results.push_back(runBenchmark("calendar_filter", classSchedule.size() + tasks.size(), repeat, noSetup, [] {
+        // Same selection as displayCalendar: today's classes, then pending tasks due by today
+        unsigned char todayBit = static_cast<unsigned char>(1u << std::max(0, getCurrentDayIndex()));
+        size_t found = 0;
+        for (size_t i = 0; i < classSchedule.size(); ++i) {
+            if (classSchedule[i].dayMask & todayBit) ++found;
+        }
+        benchSink += found + taskPriorityIndex.pendingDueBy(CivilDate::today()).size();
+    }));
+    const size_t rangeCount = std::min<size_t>(scale, 10000);
+    results.push_back(runBenchmark("task_due_week", rangeCount, repeat, noSetup, [rangeCount] {
+        // One "due this week" lookup per probe, for weeks across the generated deadline span
+        CivilDate firstWeek = CivilDate::today().plusDays(-30).weekStart();
+        for (size_t i = 0; i < rangeCount; ++i) {
+            CivilDate monday = firstWeek.plusDays(static_cast<int>(i % 53) * 7);
+            benchSink += taskPriorityIndex.pendingDueBetween(monday, monday.plusDays(6)).size();
+        }
+    }));
+
+    // --- Timetable solver ---
+    // Fixed size: a heavy term's worth of subjects, each offered in many sections
+    std::vector<TimetableSubject> candidates;
+    generate_section_candidates(candidates, 12, 50, seed + 4);
+    const std::vector<ClassDetails> noFixedClasses;
+    results.push_back(runBenchmark("timetable_solve_1_thread", 12 * 50, repeat, noSetup, [&candidates, &noFixedClasses] {
+        TimetablePreferences preferences;
+        preferences.threads = 1;
+        benchSink += solveTimetable(candidates, noFixedClasses, preferences).size();
+    }));
+    results.push_back(runBenchmark("timetable_solve", 12 * 50, repeat, noSetup, [&candidates, &noFixedClasses] {
+        TimetablePreferences preferences; // One thread per core
+        benchSink += solveTimetable(candidates, noFixedClasses, preferences).size();
+    }));
+
+    // --- Parsers ---
+    static const char* const dayInputs[] = {"Mon,Wed,Fri", "T,TH", "Saturday", "M,T,W,TH,F", "sun", "Tue, Thu"};
+    static const char* const timeInputs[] = {"09:00 AM", "12:30 PM", "07:45 am", "11:59 PM", "12:00 AM", "03:15 PM"};
+    const size_t parseCount = std::min<size_t>(scale * 10, 1000000);
+    std::vector<std::string> days(parseCount), times(parseCount), dates(parseCount);
+    for (size_t i = 0; i < parseCount; ++i) {
+        days[i] = dayInputs[rng() % 6];
+        times[i] = timeInputs[rng() % 6];
+        dates[i] = CivilDate(static_cast<int>(rng() % 40000)).toString();
+    }
+    results.push_back(runBenchmark("parse_days_of_week", parseCount, repeat, noSetup, [&days] {
+        unsigned char mask;
+        for (size_t i = 0; i < days.size(); ++i) benchSink += parseDaysOfWeek(days[i], mask) ? mask : 0;
+    }));
+    results.push_back(runBenchmark("time_to_minutes", parseCount, repeat, noSetup, [&times] {
+        for (size_t i = 0; i < times.size(); ++i) benchSink += static_cast<size_t>(timeToMinutes(times[i]));
+    }));
+    results.push_back(runBenchmark("civil_date_parse", parseCount, repeat, noSetup, [&dates] {
+        for (size_t i = 0; i < dates.size(); ++i) benchSink += static_cast<size_t>(CivilDate::parse(dates[i]).dayNumber);
+    }));
+    results.push_back(runBenchmark("civil_date_format", parseCount, repeat, noSetup, [parseCount] {
+        char text[CIVIL_DATE_LENGTH];
+        for (size_t i = 0; i < parseCount; ++i) {
+            CivilDate(static_cast<int>(i % 40000)).format(text);
+            benchSink += static_cast<unsigned char>(text[9]);
+        }
+    }));
+
+    // --- Study session queue: every card shown, one in five missed and requeued ---
+    results.push_back(runBenchmark("card_queue_session", scale, repeat, noSetup, [scale] {
+        CardQueue queue;
+        queue.reserve(scale);
+        for (size_t i = 0; i < scale; ++i) queue.push_back(i);
+        ReinsertPolicy policy = reinsert_after(5);
+        size_t shown = 0;
+        while (!queue.empty()) {
+            size_t card = queue.front();
+            queue.pop_front();
+            if (++shown % 5 == 0 && shown < scale * 2) queue.insert_at(policy(queue.size()), card);
+        }
+        benchSink += shown;
+    }));
+
+    if (format == "json") {
+        printJson(results, scale, repeat, seed);
+    } else {
+        printCsv(results);
+    }
+    return 0;
+}
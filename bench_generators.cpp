@@ -0,0 +1,154 @@
+#include "bench_generators.h"
+#include "scheduler_core.h"   // For ClassDetails, TaskDetails and their indexes
+#include "study_core.h"       // For Deck, Card, Notebook, Note
+#include "file_handler.h"     // For the global store vectors
+#include "subject_registry.h" // For the rebuild_*_subjects functions
+#include "note_search.h"      // For note_search_index
+#include "spaced_repetition.h" // For reset_due_index
+#include "timetable_solver.h" // For TimetableSubject
+#include "civil_date.h"       // For CivilDate::today
+#include <random>
+#include <string>
+
+static const size_t SUBJECT_COUNT = 40;
+static const char* const WORDS[] = {
+    "cell", "energy", "matrix", "river", "theory", "vector", "poem", "market", "enzyme", "orbit",
+    "protein", "history", "signal", "graph", "climate", "syntax", "atom", "culture", "proof", "lens"
+};
+static const size_t WORD_COUNT = sizeof(WORDS) / sizeof(WORDS[0]);
+
+static std::string subject_name(size_t index) {
+    return "Subject " + std::to_string(index % SUBJECT_COUNT + 1);
+}
+
+// `count` random words separated by spaces
+static std::string words(std::mt19937& rng, size_t count) {
+    std::string text;
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) text += ' ';
+        text += WORDS[rng() % WORD_COUNT];
+    }
+    return text;
+}
+
+// A class meeting MWF, TTh or on a single day, on the half-hour grid
+static ClassDetails random_class(std::mt19937& rng, const std::string& subject) {
+    static const unsigned char patterns[] = {0x2A, 0x14, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40}; // MWF, TTh, single days
+    ClassDetails cls;
+    cls.subject = subject;
+    cls.dayMask = patterns[rng() % (sizeof(patterns) / sizeof(patterns[0]))];
+    cls.startMinutes = 7 * 60 + static_cast<int>(rng() % 22) * 30; // 7:00 AM to 5:30 PM
+    cls.endMinutes = cls.startMinutes + (rng() % 2 == 0 ? 60 : 90);
+    cls.venue = "Room " + std::to_string(100 + rng() % 400);
+    return cls;
+}
+
+void generate_class_schedule(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    classSchedule.clear();
+    classSchedule.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::string subject = subject_name(rng());
+        classSchedule.push_back(random_class(rng, subject));
+    }
+    rebuildClassConflictIndex();
+    rebuild_class_subjects();
+}
+
+void generate_section_candidates(std::vector<TimetableSubject>& subjects, size_t subject_count,
+                                 size_t sections_per_subject, unsigned seed) {
+    std::mt19937 rng(seed);
+    subjects.assign(subject_count, TimetableSubject());
+    for (size_t i = 0; i < subject_count; ++i) {
+        subjects[i].subject = subject_name(i);
+        for (size_t k = 0; k < sections_per_subject; ++k) {
+            subjects[i].sections.push_back(random_class(rng, subjects[i].subject));
+        }
+    }
+}
+
+void generate_tasks(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    int today = CivilDate::today().dayNumber;
+    clearTasks();
+    tasks.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        TaskDetails task;
+        task.name = tasksArena.copy("Task " + std::to_string(i + 1) + " " + words(rng, 2));
+        task.subject = subject_name(rng());
+        task.infos = tasksArena.copy(words(rng, 8));
+        task.deadline = CivilDate(today - 30 + static_cast<int>(rng() % 365));
+        task.urgency = static_cast<int>(rng() % 3) + 1;
+        task.completed = rng() % 4 == 0;
+        tasks.push_back(task);
+    }
+    rebuildTaskPriorityIndex();
+    rebuild_task_subjects();
+}
+
+void generate_flashcards(size_t cards, size_t cards_per_deck, unsigned seed) {
+    std::mt19937 rng(seed);
+    if (cards_per_deck == 0) cards_per_deck = 1;
+    flashcard_decks.clear();
+    flashcard_decks.reserve(cards / cards_per_deck + 1);
+    for (size_t made = 0; made < cards; ) {
+        flashcard_decks.emplace_back();
+        Deck& deck = flashcard_decks.back();
+        deck.subject = subject_name(rng());
+        deck.title = "Deck " + std::to_string(flashcard_decks.size()) + " " + words(rng, 2);
+        deck.timestamp = "09:00:00 2025-01-01";
+        size_t size = std::min(cards_per_deck, cards - made);
+        deck.cards.reserve(size);
+        for (size_t c = 0; c < size; ++c, ++made) {
+            Card card;
+            card.question = words(rng, 7) + "?";
+            switch (rng() % 3) {
+                case 0:
+                    card.type = CARD_TRUE_FALSE;
+                    card.answer = rng() % 2 == 0 ? "true" : "false";
+                    break;
+                case 1:
+                    card.type = CARD_IDENTIFICATION;
+                    card.answer = words(rng, 2);
+                    break;
+                default:
+                    card.type = CARD_MULTIPLE_CHOICE;
+                    for (int o = 0; o < 4; ++o) card.options.push_back(words(rng, 2));
+                    card.answer = card.options[rng() % 4];
+                    break;
+            }
+            deck.cards.push_back(card);
+        }
+        reset_due_index(deck);
+    }
+    rebuild_deck_subjects();
+}
+
+void generate_notebooks(size_t notes, size_t notes_per_notebook, unsigned seed) {
+    std::mt19937 rng(seed);
+    if (notes_per_notebook == 0) notes_per_notebook = 1;
+    clear_notebooks();
+    notebooks.reserve(notes / notes_per_notebook + 1);
+    for (size_t made = 0; made < notes; ) {
+        notebooks.emplace_back();
+        Notebook& notebook = notebooks.back();
+        notebook.subject = "Subject " + std::to_string(notebooks.size()); // One notebook per subject
+        size_t size = std::min(notes_per_notebook, notes - made);
+        notebook.notes.reserve(size);
+        for (size_t n = 0; n < size; ++n, ++made) {
+            Note note;
+            note.topic_title = notebooks_arena.copy(words(rng, 3));
+            note.timestamp = notebooks_arena.copy("09:00:00 2025-01-01", 19);
+            std::string content;
+            size_t paragraphs = 1 + rng() % 4;
+            for (size_t p = 0; p < paragraphs; ++p) {
+                if (p > 0) content += "\n\n";
+                content += words(rng, 20 + rng() % 40);
+            }
+            note.content = notebooks_arena.copy(content);
+            notebook.notes.push_back(note);
+        }
+    }
+    rebuild_notebook_subjects();
+    note_search_index.build(notebooks);
+}
@@ -0,0 +1,25 @@
+#ifndef BENCH_GENERATORS_H
+#define BENCH_GENERATORS_H
+
+#include <cstddef>
+#include <vector>
+
+// --- Synthetic data for the benchmarks ---
+// Each generator replaces one store's global vector (file_handler.h) with
+// `count` records shaped like real use: a few dozen subjects, classes on a
+// half-hour grid during school hours, deadlines spread over a year, the three
+// card types in equal measure, notes of a few paragraphs. Indexes and
+// subject_registry are rebuilt, so the store is ready to query or save.
+// Output depends only on `count` and `seed`.
+void generate_class_schedule(size_t count, unsigned seed);
+void generate_tasks(size_t count, unsigned seed);
+void generate_flashcards(size_t cards, size_t cards_per_deck, unsigned seed);
+void generate_notebooks(size_t notes, size_t notes_per_notebook, unsigned seed);
+
+struct TimetableSubject;
+// Candidate sections for the timetable solver, on the same grid and day
+// patterns as generate_class_schedule. No store is touched.
+void generate_section_candidates(std::vector<TimetableSubject>& subjects, size_t subject_count,
+                                 size_t sections_per_subject, unsigned seed);
+
+#endif // BENCH_GENERATORS_H
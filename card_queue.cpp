@@ -0,0 +1,58 @@
+#include "card_queue.h"
+
+void CardQueue::reserve(size_t capacity) {
+    while (buffer.size() < capacity) grow();
+}
+
+void CardQueue::grow() {
+    size_t new_capacity = buffer.empty() ? 16 : buffer.size() * 2;
+    std::vector<size_t> larger(new_capacity);
+    for (size_t i = 0; i < count; ++i) {
+        larger[i] = buffer[(head + i) % buffer.size()];
+    }
+    buffer.swap(larger);
+    head = 0;
+}
+
+void CardQueue::pop_front() {
+    if (count == 0) return;
+    head = (head + 1) % buffer.size();
+    --count;
+}
+
+void CardQueue::push_back(size_t card_index) {
+    if (count == buffer.size()) grow();
+    at(count) = card_index;
+    ++count;
+}
+
+void CardQueue::insert_at(size_t position, size_t card_index) {
+    if (position >= count) {
+        push_back(card_index);
+        return;
+    }
+    if (count == buffer.size()) grow();
+
+    if (position <= count / 2) {
+        // Move the first `position` cards one slot towards the front.
+        head = (head + buffer.size() - 1) % buffer.size();
+        for (size_t i = 0; i < position; ++i) {
+            at(i) = at(i + 1);
+        }
+    } else {
+        // Move the cards from `position` on one slot towards the back.
+        for (size_t i = count; i > position; --i) {
+            at(i) = at(i - 1);
+        }
+    }
+    at(position) = card_index;
+    ++count;
+}
+
+ReinsertPolicy reinsert_at_tail() {
+    return [](size_t queued) { return queued; };
+}
+
+ReinsertPolicy reinsert_after(size_t gap) {
+    return [gap](size_t queued) { return gap < queued ? gap : queued; };
+}
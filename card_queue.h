@@ -0,0 +1,42 @@
+#ifndef CARD_QUEUE_H
+#define CARD_QUEUE_H
+
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+// --- Study session card queue ---
+// A growable ring buffer of card indices (into Deck::cards). pop_front and
+// push_back are O(1); insert_at shifts whichever side of the queue is shorter,
+// so putting a missed card back k places from the front costs O(min(k, n - k)).
+class CardQueue {
+public:
+    CardQueue() : head(0), count(0) {}
+
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    void reserve(size_t capacity);
+
+    size_t front() const { return buffer[head]; }
+    void pop_front();
+    void push_back(size_t card_index);
+    // Places card_index so that `position` queued cards come before it; position >= size() appends.
+    void insert_at(size_t position, size_t card_index);
+
+private:
+    size_t& at(size_t offset) { return buffer[(head + offset) % buffer.size()]; }
+    void grow();
+
+    std::vector<size_t> buffer;
+    size_t head;
+    size_t count;
+};
+
+// Decides where a missed card goes back into the queue: given the number of
+// cards still queued, returns how many of them should be shown before it.
+typedef std::function<size_t(size_t queued)> ReinsertPolicy;
+
+ReinsertPolicy reinsert_at_tail();          // Show every other queued card first (the classic behaviour)
+ReinsertPolicy reinsert_after(size_t gap);  // Show the card again after `gap` other cards
+
+#endif // CARD_QUEUE_H
@@ -0,0 +1,108 @@
+#include "card_store.h"
+#include <cstring>   // For std::memcmp, std::strlen
+#include <limits>
+#include <stdexcept> // For std::length_error
+
+static const char* const CARD_TYPE_NAMES[] = {"true_false", "identification", "multiple_choice"};
+
+const char* card_type_name(CardType type) {
+    return CARD_TYPE_NAMES[type];
+}
+
+CardType card_type_from_name(const char* text, size_t length) {
+    for (int t = 0; t < 3; ++t) {
+        if (std::strlen(CARD_TYPE_NAMES[t]) == length && std::memcmp(CARD_TYPE_NAMES[t], text, length) == 0) {
+            return static_cast<CardType>(t);
+        }
+    }
+    return CARD_IDENTIFICATION;
+}
+
+// --- CardView ---
+CardType CardView::type() const {
+    return static_cast<CardType>(store_->types_[index_]);
+}
+
+StringRef CardView::question() const {
+    return store_->text(store_->questions_[index_]);
+}
+
+StringRef CardView::answer() const {
+    return store_->text(store_->answers_[index_]);
+}
+
+size_t CardView::option_count() const {
+    size_t end = index_ + 1 < store_->size() ? store_->first_option_[index_ + 1] : store_->options_.size();
+    return end - store_->first_option_[index_];
+}
+
+StringRef CardView::option(size_t k) const {
+    return store_->text(store_->options_[store_->first_option_[index_] + k]);
+}
+
+const CardMemory& CardView::memory() const {
+    return store_->memory_[index_];
+}
+
+Card CardView::to_card() const {
+    Card card;
+    card.type = type();
+    card.question = question().str();
+    card.answer = answer().str();
+    size_t count = option_count();
+    card.options.reserve(count);
+    for (size_t k = 0; k < count; ++k) {
+        card.options.push_back(option(k).str());
+    }
+    card.memory = memory();
+    return card;
+}
+
+// --- CardStore ---
+void CardStore::reserve(size_t cards, size_t text_bytes) {
+    types_.reserve(cards);
+    questions_.reserve(cards);
+    answers_.reserve(cards);
+    first_option_.reserve(cards);
+    memory_.reserve(cards);
+    if (text_bytes > 0) text_.reserve(text_bytes);
+}
+
+void CardStore::clear() {
+    types_.clear();
+    questions_.clear();
+    answers_.clear();
+    first_option_.clear();
+    options_.clear();
+    memory_.clear();
+    text_.clear();
+}
+
+CardStore::Span CardStore::store_text(const char* text, size_t length) {
+    if (length > std::numeric_limits<uint32_t>::max() - text_.size()) {
+        throw std::length_error("CardStore: deck text exceeds 4 GiB");
+    }
+    Span span = {static_cast<uint32_t>(text_.size()), static_cast<uint32_t>(length)};
+    text_.append(text, length);
+    return span;
+}
+
+void CardStore::push_back(CardType type, const char* question, size_t question_length, const char* answer, size_t answer_length) {
+    types_.push_back(static_cast<unsigned char>(type));
+    questions_.push_back(store_text(question, question_length));
+    answers_.push_back(store_text(answer, answer_length));
+    first_option_.push_back(static_cast<uint32_t>(options_.size()));
+    memory_.push_back(CardMemory());
+}
+
+void CardStore::push_option(const char* text, size_t length) {
+    options_.push_back(store_text(text, length));
+}
+
+void CardStore::push_back(const Card& card) {
+    push_back(card.type, card.question.data(), card.question.size(), card.answer.data(), card.answer.size());
+    for (const auto& option : card.options) {
+        push_option(option.data(), option.size());
+    }
+    memory_.back() = card.memory;
+}
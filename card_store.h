@@ -0,0 +1,126 @@
+#ifndef CARD_STORE_H
+#define CARD_STORE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "arena.h" // For StringRef
+
+// --- Flashcard types and the per-deck card store ---
+
+enum CardType {
+    CARD_TRUE_FALSE,
+    CARD_IDENTIFICATION,
+    CARD_MULTIPLE_CHOICE // The only type with options
+};
+
+const char* card_type_name(CardType type); // Spelling used in .dat files and journals, e.g. "true_false"
+// Inverse of card_type_name. Unrecognized spellings read as CARD_IDENTIFICATION,
+// which shows and grades the same way, so a hand-edited file still loads.
+CardType card_type_from_name(const char* text, size_t length);
+
+// Spaced-repetition state of one card (SM-2). Saved to flashcards_srs.dat, not flashcards.dat.
+struct CardMemory {
+    double ease;       // Interval multiplier, never below 1.3
+    int interval_days; // Gap used for the last scheduling
+    int due_day;       // Day number (utils.h) the card is next due; 0 = new, due now
+    int lapses;        // Times the card was forgotten after being learned
+    int repetitions;   // Correct reviews in a row
+
+    CardMemory() : ease(2.5), interval_days(0), due_day(0), lapses(0), repetitions(0) {}
+};
+
+// A card as an owning value: what the menus fill in and what journal replay
+// builds before it is appended to a CardStore.
+struct Card {
+    CardType type;
+    std::string question;
+    std::string answer;
+    std::vector<std::string> options; // For CARD_MULTIPLE_CHOICE
+    CardMemory memory;
+
+    Card() : type(CARD_IDENTIFICATION) {}
+};
+
+class CardStore;
+
+// Read-only view of one card in a CardStore. Text comes back as StringRefs into
+// the deck's arena; they stay valid until the store is next modified.
+class CardView {
+public:
+    CardView(const CardStore& store, size_t index) : store_(&store), index_(index) {}
+
+    CardType type() const;
+    const char* type_name() const { return card_type_name(type()); }
+    StringRef question() const;
+    StringRef answer() const;
+    size_t option_count() const;
+    StringRef option(size_t k) const;
+    const CardMemory& memory() const;
+    Card to_card() const; // Owning copy
+
+private:
+    const CardStore* store_;
+    size_t index_;
+};
+
+// Cards of one deck stored column-wise: a type tag, question and answer spans
+// into one string arena, a flat pool of option spans, and the SM-2 memory.
+// A million cards cost a handful of large allocations instead of several per
+// card, and a pass over one column (types, due days) touches only that column.
+// Cards are only ever appended or cleared, matching how decks are edited.
+class CardStore {
+public:
+    CardStore() {}
+
+    size_t size() const { return types_.size(); }
+    bool empty() const { return types_.empty(); }
+    void reserve(size_t cards, size_t text_bytes = 0);
+    void clear();
+
+    void push_back(const Card& card);
+    // Appends a card; its options follow through push_option before the next card is added.
+    void push_back(CardType type, const char* question, size_t question_length, const char* answer, size_t answer_length);
+    void push_option(const char* text, size_t length);
+
+    CardView operator[](size_t index) const { return CardView(*this, index); }
+    CardMemory& memory(size_t index) { return memory_[index]; }
+    const CardMemory& memory(size_t index) const { return memory_[index]; }
+
+    // Iterates CardViews, so `for (const auto& card : deck.cards)` keeps working.
+    class const_iterator {
+    public:
+        const_iterator(const CardStore& store, size_t index) : store_(&store), index_(index) {}
+        CardView operator*() const { return CardView(*store_, index_); }
+        const_iterator& operator++() { ++index_; return *this; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+    private:
+        const CardStore* store_;
+        size_t index_;
+    };
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, size()); }
+
+private:
+    friend class CardView;
+    struct Span {
+        uint32_t offset; // Into text_; a deck's text is limited to 4 GiB
+        uint32_t length;
+    };
+    Span store_text(const char* text, size_t length);
+    StringRef text(Span span) const {
+        StringRef ref = {text_.data() + span.offset, span.length};
+        return ref;
+    }
+
+    std::vector<unsigned char> types_;    // CardType per card
+    std::vector<Span> questions_;
+    std::vector<Span> answers_;
+    std::vector<uint32_t> first_option_;  // Index into options_ of each card's first option
+    std::vector<Span> options_;           // Options of card i are [first_option_[i], first_option_[i + 1])
+    std::vector<CardMemory> memory_;
+    std::string text_;                    // Arena holding every question, answer and option
+};
+
+#endif // CARD_STORE_H
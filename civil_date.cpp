@@ -0,0 +1,129 @@
+#include "civil_date.h"
+#include <ctime>
+#include <mutex>
+#include <ostream>
+
+// Days since 1970-01-01 in the proleptic Gregorian calendar (H. Hinnant's days_from_civil).
+int daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yoe = year - era * 400;                                        // [0, 399]
+    const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1; // [0, 365]
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                   // [0, 146096]
+    return era * 146097 + doe - 719468;
+}
+
+CivilDate CivilDate::fromYmd(int year, int month, int day) {
+    static const int daysInMonth[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (year < 0 || year > 9999 || month < 1 || month > 12 || day < 1) return CivilDate();
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    int monthLength = daysInMonth[month - 1] + (month == 2 && leap ? 1 : 0);
+    if (day > monthLength) return CivilDate();
+    return CivilDate(daysFromCivil(year, month, day));
+}
+
+// Value of the `count` ASCII digits at text, or -1 if any is not a digit.
+static int parseDigits(const char* text, int count) {
+    int value = 0;
+    for (int i = 0; i < count; ++i) {
+        unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+        if (digit > 9) return -1;
+        value = value * 10 + static_cast<int>(digit);
+    }
+    return value;
+}
+
+CivilDate CivilDate::parse(const char* text, size_t length) {
+    if (length != CIVIL_DATE_LENGTH || text[4] != '-' || text[7] != '-') return CivilDate();
+    int year = parseDigits(text, 4);
+    int month = parseDigits(text + 5, 2);
+    int day = parseDigits(text + 8, 2);
+    if (year < 0 || month < 0 || day < 0) return CivilDate();
+    return fromYmd(year, month, day);
+}
+
+// Inverse of daysFromCivil (H. Hinnant's civil_from_days).
+void CivilDate::toYmd(int& year, int& month, int& day) const {
+    const int z = dayNumber + 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const int doe = z - era * 146097;                                      // [0, 146096]
+    const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+    const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);               // [0, 365]
+    const int mp = (5 * doy + 2) / 153;                                    // [0, 11]
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp + (mp < 10 ? 3 : -9);
+    year = yoe + era * 400 + (month <= 2);
+}
+
+int CivilDate::weekday() const {
+    int weekday = (dayNumber + 4) % 7; // 1970-01-01 was a Thursday
+    return weekday < 0 ? weekday + 7 : weekday;
+}
+
+CivilDate CivilDate::weekStart() const {
+    return plusDays(-((weekday() + 6) % 7));
+}
+
+void CivilDate::format(char* out) const {
+    int year, month, day;
+    if (!isValid()) {
+        for (size_t i = 0; i < CIVIL_DATE_LENGTH; ++i) out[i] = '-';
+        return;
+    }
+    toYmd(year, month, day);
+    if (year < 0 || year > 9999) year = 0; // Not reachable from parse or fromYmd
+    out[0] = static_cast<char>('0' + year / 1000);
+    out[1] = static_cast<char>('0' + year / 100 % 10);
+    out[2] = static_cast<char>('0' + year / 10 % 10);
+    out[3] = static_cast<char>('0' + year % 10);
+    out[4] = '-';
+    out[5] = static_cast<char>('0' + month / 10);
+    out[6] = static_cast<char>('0' + month % 10);
+    out[7] = '-';
+    out[8] = static_cast<char>('0' + day / 10);
+    out[9] = static_cast<char>('0' + day % 10);
+}
+
+std::string CivilDate::toString() const {
+    char buffer[CIVIL_DATE_LENGTH];
+    format(buffer);
+    return std::string(buffer, CIVIL_DATE_LENGTH);
+}
+
+std::ostream& operator<<(std::ostream& out, CivilDate date) {
+    char buffer[CIVIL_DATE_LENGTH];
+    date.format(buffer);
+    return out.write(buffer, static_cast<std::streamsize>(CIVIL_DATE_LENGTH));
+}
+
+// --- Today ---
+static bool localDate(std::time_t when, std::tm& local) {
+#if defined(_WIN32) && defined(_MSC_VER)
+    return localtime_s(&local, &when) == 0;
+#elif defined(__unix__) || defined(__APPLE__)
+    return localtime_r(&when, &local) != nullptr;
+#else
+    std::tm* shared = std::localtime(&when);
+    if (!shared) return false;
+    local = *shared;
+    return true;
+#endif
+}
+
+CivilDate CivilDate::today() {
+    static std::mutex cacheMutex; // Stores are loaded on worker threads (startup_loader.h)
+    static CivilDate cachedDate;
+    static std::time_t validUntil = 0;
+
+    std::time_t now = std::time(nullptr);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (now < validUntil && cachedDate.isValid()) return cachedDate;
+
+    std::tm local;
+    if (!localDate(now, local)) return CivilDate();
+    cachedDate = fromYmd(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+    // Seconds left before local midnight, capped so a DST change is noticed within the hour.
+    long untilMidnight = 86400L - (local.tm_hour * 3600L + local.tm_min * 60L + local.tm_sec);
+    validUntil = now + (untilMidnight < 3600 ? untilMidnight : 3600);
+    return cachedDate;
+}
@@ -0,0 +1,53 @@
+#ifndef CIVIL_DATE_H
+#define CIVIL_DATE_H
+
+#include <string>
+#include <cstddef>
+#include <iosfwd>
+
+// --- Calendar dates as day numbers ---
+// A date is stored as its day number (days since 1970-01-01, proleptic
+// Gregorian), so deadlines compare, sort and subtract as plain ints and cost
+// four bytes. Text is always "YYYY-MM-DD"; parse and format are hand-written
+// and do not allocate.
+
+const int INVALID_DAY_NUMBER = 2147483647; // Sorts after every real date
+const size_t CIVIL_DATE_LENGTH = 10;       // strlen("YYYY-MM-DD")
+
+int daysFromCivil(int year, int month, int day); // No range check; see CivilDate::fromYmd
+
+struct CivilDate {
+    int dayNumber; // INVALID_DAY_NUMBER when not a date
+
+    CivilDate() : dayNumber(INVALID_DAY_NUMBER) {}
+    explicit CivilDate(int day) : dayNumber(day) {}
+
+    // Invalid unless year is 0-9999 and the day exists in that month.
+    static CivilDate fromYmd(int year, int month, int day);
+    // Strict "YYYY-MM-DD": exactly ten characters, no surrounding spaces.
+    static CivilDate parse(const char* text, size_t length);
+    static CivilDate parse(const std::string& text) { return parse(text.data(), text.size()); }
+    // Today's local date. The localtime call is made once and reused until the
+    // next local midnight (rechecked at least hourly), so this is cheap to call.
+    static CivilDate today();
+
+    bool isValid() const { return dayNumber != INVALID_DAY_NUMBER; }
+    void toYmd(int& year, int& month, int& day) const; // Only for valid dates
+    int weekday() const;           // 0=Sun .. 6=Sat, matching tm_wday and the class day masks
+    CivilDate weekStart() const;   // The Monday on or before this date
+    CivilDate plusDays(int days) const { return CivilDate(dayNumber + days); }
+
+    // Writes CIVIL_DATE_LENGTH characters (no terminator); "----------" if invalid.
+    void format(char* out) const;
+    std::string toString() const;
+
+    bool operator==(CivilDate other) const { return dayNumber == other.dayNumber; }
+    bool operator!=(CivilDate other) const { return dayNumber != other.dayNumber; }
+    bool operator<(CivilDate other) const { return dayNumber < other.dayNumber; }
+    bool operator<=(CivilDate other) const { return dayNumber <= other.dayNumber; }
+    bool operator>(CivilDate other) const { return dayNumber > other.dayNumber; }
+    bool operator>=(CivilDate other) const { return dayNumber >= other.dayNumber; }
+};
+std::ostream& operator<<(std::ostream& out, CivilDate date);
+
+#endif // CIVIL_DATE_H
@@ -0,0 +1,156 @@
+#include "class_import.h"
+#include "scheduler_core.h"    // For ClassDetails, classConflictIndex
+#include "file_handler.h"      // For classSchedule, saveClassScheduleToFile
+#include "subject_registry.h"  // For rebuild_class_subjects
+#include "mapped_file.h"       // The CSV is mapped, not streamed through iostreams
+#include "csv_reader.h"        // For CsvReader
+#include "utils.h"             // For day and time parsing
+#include <algorithm>           // For std::sort
+
+// One meeting of a class on one weekday. `owner` < existingCount is a
+// classSchedule index; otherwise it is existingCount + the row's batch index.
+struct SweepInterval {
+    int start;
+    int end;
+    size_t owner;
+};
+
+static std::string describe_class(const ClassDetails& cls) {
+    return cls.subject + " (" + dayMaskToString(cls.dayMask) + " " +
+           minutesToTimeString(cls.startMinutes) + "-" + minutesToTimeString(cls.endMinutes) + ")";
+}
+
+const char* parse_class_row(const std::vector<std::string>& fields, ClassDetails& cls) {
+    if (fields.size() < 4 || fields.size() > 5) return "expected 4 or 5 fields: subject,days,start,end[,venue]";
+    if (fields[0].empty()) return "subject is empty";
+    if (!parseDaysOfWeek(fields[1], cls.dayMask) || cls.dayMask == 0) return "unrecognized days";
+    if ((cls.startMinutes = timeToMinutes(fields[2])) == -1 || (cls.endMinutes = timeToMinutes(fields[3])) == -1) {
+        return "times must look like 09:30 AM";
+    }
+    if (cls.startMinutes >= cls.endMinutes) return "start time must be before end time";
+    cls.subject = fields[0];
+    cls.venue = fields.size() == 5 ? fields[4] : std::string();
+    return nullptr;
+}
+
+bool import_classes_csv(const std::string& path, ClassImportReport& report, bool commit) {
+    report = ClassImportReport();
+    MappedFile input;
+    if (!input.open(path)) return false;
+
+    // 1. Parse and check each row on its own
+    std::vector<ClassDetails> batch;
+    std::vector<size_t> batchLines;
+    std::vector<bool> rowRejected;
+    CsvReader reader(input.data(), input.size());
+    std::vector<std::string> fields;
+    bool first = true;
+    while (reader.next_record(fields)) {
+        if (first) {
+            first = false;
+            std::string head = fields[0];
+            std::transform(head.begin(), head.end(), head.begin(), ::tolower);
+            if (head == "subject") continue; // Optional header row
+        }
+        report.rowsRead++;
+        ClassDetails cls;
+        const char* problem = parse_class_row(fields, cls);
+        if (problem) {
+            ClassImportIssue issue;
+            issue.line = reader.line_number();
+            issue.message = problem;
+            report.issues.push_back(issue);
+            report.rejected++;
+            continue;
+        }
+        batch.push_back(cls);
+        batchLines.push_back(reader.line_number());
+        rowRejected.push_back(false);
+    }
+    input.close();
+
+    // 2. One sweep per weekday over the existing classes and the valid rows together
+    const size_t existingCount = classSchedule.size();
+    std::vector<SweepInterval> day;
+    std::vector<std::pair<size_t, size_t> > overlaps; // (batch index, owner it overlaps)
+    for (int d = 0; d < 7; ++d) {
+        day.clear();
+        unsigned char bit = static_cast<unsigned char>(1u << d);
+        for (size_t i = 0; i < existingCount; ++i) {
+            const ClassDetails& cls = classSchedule[i];
+            if ((cls.dayMask & bit) && cls.startMinutes >= 0 && cls.endMinutes > cls.startMinutes) {
+                SweepInterval interval = {cls.startMinutes, cls.endMinutes, i};
+                day.push_back(interval);
+            }
+        }
+        for (size_t i = 0; i < batch.size(); ++i) {
+            if (batch[i].dayMask & bit) {
+                SweepInterval interval = {batch[i].startMinutes, batch[i].endMinutes, existingCount + i};
+                day.push_back(interval);
+            }
+        }
+        std::sort(day.begin(), day.end(), [](const SweepInterval& a, const SweepInterval& b) {
+            return a.start != b.start ? a.start < b.start : a.owner < b.owner;
+        });
+
+        // An interval starting before the furthest end seen so far overlaps the
+        // interval that owns that end. Every overlapping interval is caught this
+        // way, either directly or as the owner of the furthest end.
+        int furthestEnd = -1;
+        size_t furthestOwner = 0;
+        for (size_t k = 0; k < day.size(); ++k) {
+            const SweepInterval& current = day[k];
+            if (current.start < furthestEnd) {
+                if (current.owner >= existingCount) {
+                    overlaps.push_back(std::make_pair(current.owner - existingCount, furthestOwner));
+                }
+                if (furthestOwner >= existingCount) {
+                    overlaps.push_back(std::make_pair(furthestOwner - existingCount, current.owner));
+                }
+            }
+            if (current.end > furthestEnd) {
+                furthestEnd = current.end;
+                furthestOwner = current.owner;
+            }
+        }
+    }
+
+    // 3. Reject every row that overlaps anything, in file order. The sweep only pairs
+    // an interval with the owner of the furthest end, so a rejected row names at
+    // least one class it overlaps, not necessarily every one.
+    std::sort(overlaps.begin(), overlaps.end());
+    overlaps.erase(std::unique(overlaps.begin(), overlaps.end()), overlaps.end());
+    for (size_t k = 0; k < overlaps.size(); ++k) {
+        size_t row = overlaps[k].first;
+        size_t owner = overlaps[k].second;
+        if (!rowRejected[row]) {
+            rowRejected[row] = true;
+            report.rejected++;
+        }
+        ClassImportIssue issue;
+        issue.line = batchLines[row];
+        if (owner < existingCount) {
+            issue.message = "overlaps existing class " + describe_class(classSchedule[owner]);
+        } else {
+            issue.message = "overlaps line " + std::to_string(batchLines[owner - existingCount]) + ", " +
+                            describe_class(batch[owner - existingCount]);
+        }
+        report.issues.push_back(issue);
+    }
+    std::stable_sort(report.issues.begin(), report.issues.end(), [](const ClassImportIssue& a, const ClassImportIssue& b) {
+        return a.line < b.line;
+    });
+
+    // 4. Commit what passed with one index rebuild and one save
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (rowRejected[i]) continue;
+        report.imported++;
+        if (commit) classSchedule.push_back(batch[i]);
+    }
+    if (commit && report.imported > 0) {
+        rebuildClassConflictIndex();
+        rebuild_class_subjects();
+        saveClassScheduleToFile();
+    }
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef CLASS_IMPORT_H
+#define CLASS_IMPORT_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// --- Bulk class import ---
+// Reads classes from a CSV file (subject,days,start,end[,venue], the columns
+// `export classes` writes; a header row is optional) and validates the whole
+// batch at once: every row against the existing schedule and against every
+// other row. Overlaps are found by sorting each weekday's intervals by start
+// and sweeping once, so a batch costs O((n + m) log(n + m)) for n rows and m
+// existing classes instead of one conflict check and one save per row.
+//
+// Two rows that overlap each other are both rejected, since nothing says which
+// one is right; a row overlapping an existing class is rejected and the class
+// kept. Each rejected row's issues name a conflicting class, not necessarily
+// all of them. Everything else is appended to classSchedule and saved in one snapshot.
+
+struct ClassImportIssue {
+    size_t line;         // 1-based line of the rejected row in the CSV file
+    std::string message; // e.g. "overlaps Math (Mon 09:00 AM-10:30 AM)"
+};
+
+struct ClassImportReport {
+    size_t rowsRead;
+    size_t imported;
+    size_t rejected;                      // Rows not imported; each has one or more issues
+    std::vector<ClassImportIssue> issues; // Ordered by line
+
+    ClassImportReport() : rowsRead(0), imported(0), rejected(0) {}
+};
+
+struct ClassDetails;
+
+// Parses one subject,days,start,end[,venue] row into `cls`. Returns nullptr if
+// the row is valid, otherwise what is wrong with it.
+const char* parse_class_row(const std::vector<std::string>& fields, ClassDetails& cls);
+
+// Returns false only if `path` can't be read. With commit == false the batch is
+// validated and reported but the schedule is left untouched (a dry run).
+bool import_classes_csv(const std::string& path, ClassImportReport& report, bool commit = true);
+
+#endif // CLASS_IMPORT_H
@@ -0,0 +1,460 @@
+#include "cli.h"
+#include "scheduler_planner.h" // For classSchedule, tasks and their indexes
+#include "file_handler.h"      // For the save functions
+#include "startup_loader.h"    // For ensureScheduleLoaded, ensureTasksLoaded
+#include "subject_registry.h"  // For rebuild_task_subjects
+#include "mapped_file.h"       // Import files are mapped, not streamed
+#include "csv_reader.h"        // For CsvReader, append_csv_field
+#include "class_import.h"      // For import_classes_csv
+#include "timetable_solver.h"  // For solveTimetable, readSectionCandidatesCsv
+#include "atomic_file.h"       // For exporting to a file
+#include "flashcard_binary.h"  // For the flashcard store converters
+#include "utils.h"             // For time, day and date conversions
+#include <iostream>
+#include <cstring>             // For std::strcmp, std::strlen
+#include <cstdlib>             // For std::strtol
+#include <limits>              // For std::numeric_limits
+#include <algorithm>           // For std::transform
+#include <cctype>              // For ::tolower
+
+static void print_cli_usage() {
+    std::cerr << "Usage: iskaalaman_system [command]\n"
+              << "Without a command the interactive menus start.\n\n"
+              << "Commands:\n"
+              << "  import-tasks FILE.csv           Add tasks from CSV rows: name,subject,infos,deadline,urgency[,completed]\n"
+              << "  import-classes FILE.csv [--dry-run]\n"
+              << "                                  Add classes from CSV rows: subject,days,start,end[,venue]\n"
+              << "  add-class SUBJECT DAYS START END VENUE [...]\n"
+              << "                                  Add classes; repeat the five fields to add several\n"
+              << "  list-due [--date YYYY-MM-DD]    Pending tasks due on or before the date (default today)\n"
+              << "  list-due --week                 Pending tasks due this week (Monday to Sunday)\n"
+              << "  list-due --from DATE [--to DATE]\n"
+              << "                                  Pending tasks due in a date range (either end optional)\n"
+              << "  list-due --overdue N            Pending tasks more than N days past their deadline\n"
+              << "  plan-sections FILE.csv [--top N] [--earliest TIME] [--threads N] [--max-nodes N] [--apply RANK]\n"
+              << "                                  Rank conflict-free picks of one section per subject from CSV\n"
+              << "                                  rows subject,days,start,end[,venue]; --apply adds pick RANK\n"
+              << "  export tasks|classes [FILE]     Write CSV to FILE or standard output\n"
+              << "  convert-flashcards [--to-text]  Rebuild flashcards.bin from flashcards.dat, or the reverse\n"
+              << "  help                            Show this message\n";
+}
+
+// "1"/"2"/"3" or the names urgencyToString prints; 0 if unrecognized.
+static int parse_urgency(const std::string& text) {
+    std::string lower = text;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    if (lower == "1" || lower == "high") return 1;
+    if (lower == "2" || lower == "moderate") return 2;
+    if (lower == "3" || lower == "low") return 3;
+    return 0;
+}
+
+// --- import-tasks ---
+static int import_tasks(const std::string& path) {
+    MappedFile input;
+    if (!input.open(path)) {
+        std::cerr << "Error: Could not read " << path << "." << std::endl;
+        return 1;
+    }
+    ensureTasksLoaded(); // From startup_loader.h
+
+    CsvReader reader(input.data(), input.size());
+    std::vector<std::string> fields;
+    size_t imported = 0, rejected = 0;
+    bool first = true;
+    while (reader.next_record(fields)) {
+        if (first) {
+            first = false;
+            std::string head = fields[0];
+            std::transform(head.begin(), head.end(), head.begin(), ::tolower);
+            if (head == "name") continue; // Optional header row
+        }
+        const char* problem = nullptr;
+        TaskDetails task;
+        if (fields.size() < 5 || fields.size() > 6) {
+            problem = "expected 5 or 6 fields";
+        } else if (fields[0].empty()) {
+            problem = "task name is empty";
+        } else if (!(task.deadline = CivilDate::parse(fields[3])).isValid()) {
+            problem = "deadline is not a valid YYYY-MM-DD date";
+        } else if ((task.urgency = parse_urgency(fields[4])) == 0) {
+            problem = "urgency must be 1-3 or High/Moderate/Low";
+        } else if (fields.size() == 6 && fields[5] != "0" && fields[5] != "1" && !fields[5].empty()) {
+            problem = "completed must be 0 or 1";
+        }
+        if (problem) {
+            std::cerr << path << ":" << reader.line_number() << ": " << problem << "; row skipped." << std::endl;
+            ++rejected;
+            continue;
+        }
+        task.name = tasksArena.copy(fields[0]);
+        task.subject = fields[1];
+        task.infos = tasksArena.copy(fields[2].empty() ? std::string("No info available") : fields[2]); // Same default as addTask
+        task.completed = fields.size() == 6 && fields[5] == "1";
+        tasks.push_back(task); // Indexed once below, not per row
+        ++imported;
+    }
+    input.close();
+
+    if (imported > 0) {
+        rebuildTaskPriorityIndex(); // One sorted bulk build beats a set insert per row
+        rebuild_task_subjects();
+        saveTasksToFile(); // One snapshot for the whole batch instead of a journal record per task
+    }
+    std::cout << "Imported " << imported << " task(s); " << rejected << " row(s) rejected." << std::endl;
+    return rejected == 0 ? 0 : 1;
+}
+
+// --- import-classes ---
+static int import_classes(int argc, char* argv[], int first) {
+    bool dryRun = false;
+    std::string path;
+    for (int i = first; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--dry-run") == 0) {
+            dryRun = true;
+        } else if (path.empty()) {
+            path = argv[i];
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        std::cerr << "Error: import-classes takes one FILE.csv and an optional --dry-run." << std::endl;
+        return 2;
+    }
+    ensureScheduleLoaded();
+
+    ClassImportReport report;
+    if (!import_classes_csv(path, report, !dryRun)) { // From class_import.h
+        std::cerr << "Error: Could not read " << path << "." << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < report.issues.size(); ++i) {
+        std::cerr << path << ":" << report.issues[i].line << ": " << report.issues[i].message << std::endl;
+    }
+    std::cout << (dryRun ? "Would import " : "Imported ") << report.imported << " of " << report.rowsRead
+              << " class(es); " << report.rejected << " rejected." << std::endl;
+    return report.rejected == 0 ? 0 : 1;
+}
+
+// --- add-class ---
+static int add_classes(int argc, char* argv[], int first) {
+    int count = argc - first;
+    if (count <= 0 || count % 5 != 0) {
+        std::cerr << "Error: add-class takes SUBJECT DAYS START END VENUE, repeated for each class." << std::endl;
+        return 2;
+    }
+    ensureScheduleLoaded();
+
+    size_t added = 0, rejected = 0;
+    for (int i = first; i < argc; i += 5) {
+        int number = (i - first) / 5 + 1;
+        ClassDetails cls;
+        cls.subject = argv[i];
+        cls.startMinutes = timeToMinutes(argv[i + 2]);
+        cls.endMinutes = timeToMinutes(argv[i + 3]);
+        cls.venue = argv[i + 4];
+        const char* problem = nullptr;
+        if (!parseDaysOfWeek(argv[i + 1], cls.dayMask) || cls.dayMask == 0) {
+            problem = "unrecognized days";
+        } else if (cls.startMinutes == -1 || cls.endMinutes == -1) {
+            problem = "times must look like 09:30 AM";
+        } else if (cls.startMinutes >= cls.endMinutes) {
+            problem = "start time must be before end time";
+        }
+        if (problem) {
+            std::cerr << "Class " << number << " (" << cls.subject << "): " << problem << "; not added." << std::endl;
+            ++rejected;
+            continue;
+        }
+        // Classes accepted earlier in this batch are already indexed, so they are checked too.
+        std::vector<size_t> conflicts = classConflictIndex.findConflicts(cls);
+        if (!conflicts.empty()) {
+            const ClassDetails& other = classSchedule[conflicts[0]];
+            std::cerr << "Class " << number << " (" << cls.subject << "): conflicts with " << other.subject << " "
+                      << dayMaskToString(other.dayMask) << " " << minutesToTimeString(other.startMinutes) << "-"
+                      << minutesToTimeString(other.endMinutes) << "; not added." << std::endl;
+            ++rejected;
+            continue;
+        }
+        appendClass(cls);
+        ++added;
+    }
+
+    if (added > 0) {
+        saveClassScheduleToFile();
+    }
+    std::cout << "Added " << added << " class(es); " << rejected << " rejected." << std::endl;
+    return rejected == 0 ? 0 : 1;
+}
+
+// --- list-due ---
+static bool parse_date_argument(const char* option, const char* text, CivilDate& date) {
+    date = CivilDate::parse(text, std::strlen(text));
+    if (!date.isValid()) {
+        std::cerr << "Error: " << option << " must be a valid YYYY-MM-DD date." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static int list_due(int argc, char* argv[], int first) {
+    // Every form is one range lookup in the deadline index: [from, to].
+    CivilDate today = CivilDate::today();
+    CivilDate from(std::numeric_limits<int>::min());
+    CivilDate to = today;
+    int forms = 0; // --date, --week, --from/--to and --overdue are alternatives
+    bool range = false;
+    for (int i = first; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--date") == 0 && has_value) {
+            if (!parse_date_argument("--date", argv[++i], to)) return 2;
+            ++forms;
+        } else if (std::strcmp(argv[i], "--week") == 0) {
+            from = today.weekStart();
+            to = from.plusDays(6);
+            ++forms;
+        } else if (std::strcmp(argv[i], "--from") == 0 && has_value) {
+            if (!parse_date_argument("--from", argv[++i], from)) return 2;
+            if (!range) to = CivilDate::fromYmd(9999, 12, 31); // No upper bound unless --to follows
+            if (!range) ++forms;
+            range = true;
+        } else if (std::strcmp(argv[i], "--to") == 0 && has_value) {
+            if (!parse_date_argument("--to", argv[++i], to)) return 2;
+            if (!range) ++forms;
+            range = true;
+        } else if (std::strcmp(argv[i], "--overdue") == 0 && has_value) {
+            char* end;
+            long days = std::strtol(argv[++i], &end, 10);
+            if (*end != '\0' || days < 0 || days > 100000) {
+                std::cerr << "Error: --overdue takes a number of days." << std::endl;
+                return 2;
+            }
+            to = today.plusDays(-static_cast<int>(days) - 1); // Overdue by more than `days` days
+            ++forms;
+        } else {
+            std::cerr << "Error: unknown argument '" << argv[i] << "' for list-due." << std::endl;
+            return 2;
+        }
+    }
+    if (forms > 1) {
+        std::cerr << "Error: use only one of --date, --week, --from/--to and --overdue." << std::endl;
+        return 2;
+    }
+    ensureTasksLoaded();
+
+    std::vector<size_t> due = taskPriorityIndex.pendingDueBetween(from, to); // Ordered by deadline
+    std::string out = "deadline,urgency,subject,name\n";
+    for (size_t i = 0; i < due.size(); ++i) {
+        const TaskDetails& task = tasks[due[i]];
+        char deadline[CIVIL_DATE_LENGTH];
+        task.deadline.format(deadline);
+        out.append(deadline, CIVIL_DATE_LENGTH);
+        out += ',';
+        out += urgencyToString(task.urgency);
+        out += ',';
+        append_csv_field(out, task.subject);
+        out += ',';
+        append_csv_field(out, task.name.data, task.name.size);
+        out += '\n';
+    }
+    std::cout << out;
+    return 0;
+}
+
+// --- plan-sections ---
+// Parses a whole non-negative number no larger than `limit`.
+static bool parse_count_argument(const char* option, const char* text, unsigned long long limit,
+                                 unsigned long long& value) {
+    char* end;
+    long long parsed = std::strtoll(text, &end, 10);
+    if (*end != '\0' || end == text || parsed < 0 || static_cast<unsigned long long>(parsed) > limit) {
+        std::cerr << "Error: " << option << " takes a number from 0 to " << limit << "." << std::endl;
+        return false;
+    }
+    value = static_cast<unsigned long long>(parsed);
+    return true;
+}
+
+static int plan_sections(int argc, char* argv[], int first) {
+    TimetablePreferences preferences;
+    std::string path;
+    unsigned long long apply = 0, value;
+    for (int i = first; i < argc; ++i) {
+        bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--top") == 0 && has_value) {
+            if (!parse_count_argument("--top", argv[++i], 1000, value)) return 2;
+            if (value == 0) {
+                std::cerr << "Error: --top must be at least 1." << std::endl;
+                return 2;
+            }
+            preferences.maxResults = static_cast<size_t>(value);
+        } else if (std::strcmp(argv[i], "--earliest") == 0 && has_value) {
+            preferences.earliestStartMinutes = timeToMinutes(argv[++i]);
+            if (preferences.earliestStartMinutes == -1) {
+                std::cerr << "Error: --earliest takes a time like 09:00 AM." << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--threads") == 0 && has_value) {
+            if (!parse_count_argument("--threads", argv[++i], 256, value)) return 2;
+            preferences.threads = static_cast<unsigned>(value);
+        } else if (std::strcmp(argv[i], "--max-nodes") == 0 && has_value) {
+            if (!parse_count_argument("--max-nodes", argv[++i], std::numeric_limits<long long>::max(), value)) return 2;
+            preferences.nodeLimit = value;
+        } else if (std::strcmp(argv[i], "--apply") == 0 && has_value) {
+            if (!parse_count_argument("--apply", argv[++i], 1000, apply)) return 2;
+        } else if (path.empty() && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            std::cerr << "Error: unknown argument '" << argv[i] << "' for plan-sections." << std::endl;
+            return 2;
+        }
+    }
+    if (path.empty()) {
+        std::cerr << "Error: plan-sections takes a FILE.csv of candidate sections." << std::endl;
+        return 2;
+    }
+    if (apply > preferences.maxResults) preferences.maxResults = static_cast<size_t>(apply);
+
+    std::vector<TimetableSubject> subjects;
+    std::vector<ClassImportIssue> issues;
+    if (!readSectionCandidatesCsv(path, subjects, issues)) { // From timetable_solver.h
+        std::cerr << "Error: Could not read " << path << "." << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < issues.size(); ++i) {
+        std::cerr << path << ":" << issues[i].line << ": " << issues[i].message << "; skipped" << std::endl;
+    }
+    if (subjects.empty()) {
+        std::cerr << "Error: " << path << " has no valid sections." << std::endl;
+        return 1;
+    }
+    ensureScheduleLoaded();
+
+    // Classes already in the schedule stay put; the sections are fitted around them
+    TimetableSolveStats stats;
+    std::vector<TimetableSolution> solutions = solveTimetable(subjects, classSchedule, preferences, &stats);
+    std::cerr << "Searched " << stats.nodes << " node(s) on " << stats.threads << " thread(s): " << stats.complete
+              << " conflict-free combination(s) scored, " << stats.pruned << " branch(es) pruned"
+              << (stats.exhaustive ? "." : "; stopped at --max-nodes, so better picks may exist.") << std::endl;
+    if (solutions.empty()) {
+        std::cerr << "No combination of these sections fits without a conflict." << std::endl;
+        return 1;
+    }
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        printTimetableSolution(i + 1, subjects, solutions[i]); // From scheduler_planner.h
+    }
+    if (apply == 0) return 0;
+    if (apply > solutions.size()) {
+        std::cerr << "Error: only " << solutions.size() << " combination(s) found; nothing added." << std::endl;
+        return 1;
+    }
+    const TimetableSolution& chosen = solutions[apply - 1];
+    for (size_t i = 0; i < subjects.size(); ++i) {
+        appendClass(subjects[i].sections[chosen.sections[i]]);
+    }
+    saveClassScheduleToFile();
+    std::cout << "Added " << subjects.size() << " class(es) from combination #" << apply << "." << std::endl;
+    return 0;
+}
+
+// --- export ---
+// Rows use the same columns the importers read, so an export can be imported elsewhere.
+static void export_tasks_csv(std::string& out) {
+    out += "name,subject,infos,deadline,urgency,completed\n";
+    for (const auto& task : tasks) {
+        if (task.removed) continue;
+        append_csv_field(out, task.name.data, task.name.size);
+        out += ',';
+        append_csv_field(out, task.subject);
+        out += ',';
+        append_csv_field(out, task.infos.data, task.infos.size);
+        out += ',';
+        append_csv_field(out, taskDeadlineText(task)); // Unparsable text is kept, so it may need quoting
+        out += ',';
+        out += std::to_string(task.urgency);
+        out += task.completed ? ",1\n" : ",0\n";
+    }
+}
+
+static void export_classes_csv(std::string& out) {
+    out += "subject,days,start,end,venue\n";
+    for (const auto& cls : classSchedule) {
+        append_csv_field(out, cls.subject);
+        out += ',';
+        append_csv_field(out, dayMaskToString(cls.dayMask));
+        out += ',';
+        append_csv_field(out, classTimeText(cls.startMinutes, cls.unparsedStart)); // Unparsable text may need quoting
+        out += ',';
+        append_csv_field(out, classTimeText(cls.endMinutes, cls.unparsedEnd));
+        out += ',';
+        append_csv_field(out, cls.venue);
+        out += '\n';
+    }
+}
+
+static int export_store(int argc, char* argv[], int first) {
+    if (first >= argc || argc - first > 2) {
+        std::cerr << "Error: export takes tasks|classes and an optional FILE." << std::endl;
+        return 2;
+    }
+    std::string what = argv[first];
+    std::string out;
+    if (what == "tasks") {
+        ensureTasksLoaded();
+        export_tasks_csv(out);
+    } else if (what == "classes") {
+        ensureScheduleLoaded();
+        export_classes_csv(out);
+    } else {
+        std::cerr << "Error: can only export 'tasks' or 'classes'." << std::endl;
+        return 2;
+    }
+    if (first + 1 < argc) {
+        return write_file_atomically(argv[first + 1], out) ? 0 : 1; // From atomic_file.h
+    }
+    std::cout << out;
+    return std::cout ? 0 : 1;
+}
+
+// --- convert-flashcards ---
+// Builds flashcards.bin from flashcards.dat, or (--to-text) flashcards.dat from
+// flashcards.bin and the journal on top of it, after which both mirror the new text.
+static int convert_flashcards(int argc, char* argv[], int first) {
+    bool toText = false;
+    if (first < argc && std::strcmp(argv[first], "--to-text") == 0) {
+        toText = true;
+        ++first;
+    }
+    if (first < argc) {
+        std::cerr << "Error: convert-flashcards takes only an optional --to-text." << std::endl;
+        return 2;
+    }
+    const std::string& from = toText ? FLASHCARDS_BINARY_FILE : FLASHCARDS_FILE; // From file_handler.h
+    const std::string& to = toText ? FLASHCARDS_FILE : FLASHCARDS_BINARY_FILE;
+    bool converted = toText ? rebuild_flashcards_text_from_binary() : convert_flashcards_text_to_binary(from, to);
+    if (!converted) {
+        std::cerr << "Error: Could not convert " << from << " to " << to << "." << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << to << " from " << from << "." << std::endl;
+    return 0;
+}
+
+int run_cli_command(int argc, char* argv[]) {
+    std::string command = argc > 1 ? argv[1] : "help";
+    if (command == "import-tasks" && argc == 3) return import_tasks(argv[2]);
+    if (command == "import-classes") return import_classes(argc, argv, 2);
+    if (command == "add-class") return add_classes(argc, argv, 2);
+    if (command == "list-due") return list_due(argc, argv, 2);
+    if (command == "plan-sections") return plan_sections(argc, argv, 2);
+    if (command == "export") return export_store(argc, argv, 2);
+    if (command == "convert-flashcards") return convert_flashcards(argc, argv, 2);
+    if (command == "help" || command == "--help" || command == "-h") {
+        print_cli_usage();
+        return 0;
+    }
+    print_cli_usage();
+    return 2;
+}
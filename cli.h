@@ -0,0 +1,23 @@
+#ifndef CLI_H
+#define CLI_H
+
+// --- Non-interactive command mode ---
+// `iskaalaman_system <command> [args]` runs one batch operation and exits, for
+// scripts and scheduled jobs. Every command loads the stores it needs once and
+// saves each changed store once, however many records it touches:
+//
+//   import-tasks FILE.csv             name,subject,infos,deadline,urgency[,completed]
+//   import-classes FILE.csv [--dry-run]  subject,days,start,end[,venue]; see class_import.h
+//   add-class SUBJECT DAYS START END VENUE [SUBJECT DAYS START END VENUE ...]
+//   list-due [--date YYYY-MM-DD]      pending tasks due on or before the date (default today)
+//   list-due --week | --from DATE [--to DATE] | --overdue N
+//                                     due this week, due in a range, or more than N days late
+//   export tasks|classes [FILE]       CSV to FILE, or to standard output
+//
+// Times use the interactive format ("09:30 AM") and days the same tokens as the
+// menus ("Mon,Wed" or "M,W"). Rejected records are reported on standard error.
+// Returns the process exit code: 0 on success, 1 if any record was rejected or
+// a file failed, 2 on a usage error.
+int run_cli_command(int argc, char* argv[]);
+
+#endif // CLI_H
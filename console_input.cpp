@@ -0,0 +1,15 @@
+#include "console_input.h"
+#include <iostream>
+#include <limits>
+
+// --- General Input Helper Functions ---
+void clear_input_buffer() {
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+}
+
+std::string get_string_input(const std::string& prompt) {
+    std::string input;
+    std::cout << prompt;
+    std::getline(std::cin, input); // Assumes cin buffer is clean or handled before this call
+    return input;
+}
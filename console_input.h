@@ -0,0 +1,11 @@
+#ifndef CONSOLE_INPUT_H
+#define CONSOLE_INPUT_H
+
+#include <string>
+
+// Prompt helpers for the interactive menus. Kept out of utils so that
+// libiskaalaman_core never touches std::cin.
+void clear_input_buffer();                               // Discards the rest of the current input line
+std::string get_string_input(const std::string& prompt); // Prints prompt, reads one line
+
+#endif // CONSOLE_INPUT_H
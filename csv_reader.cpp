@@ -0,0 +1,72 @@
+#include "csv_reader.h"
+#include <algorithm> // For std::find_if
+
+bool CsvReader::next_record(std::vector<std::string>& fields) {
+    // Skip blank lines between records
+    while (cursor_ < end_ && (*cursor_ == '\n' || *cursor_ == '\r')) {
+        if (*cursor_ == '\n') ++line_;
+        ++cursor_;
+    }
+    if (cursor_ >= end_) return false;
+    record_line_ = line_;
+
+    size_t count = 0;
+    while (true) {
+        if (count == fields.size()) fields.push_back(std::string());
+        std::string& field = fields[count++];
+        field.clear();
+
+        if (cursor_ < end_ && *cursor_ == '"') {
+            ++cursor_;
+            while (cursor_ < end_) {
+                char c = *cursor_++;
+                if (c == '"') {
+                    if (cursor_ < end_ && *cursor_ == '"') { // Escaped quote
+                        field += '"';
+                        ++cursor_;
+                    } else {
+                        break; // Closing quote
+                    }
+                } else {
+                    if (c == '\n') ++line_;
+                    field += c;
+                }
+            }
+        }
+        // Unquoted field, or anything trailing a closing quote, runs to the next comma or line break
+        const char* start = cursor_;
+        while (cursor_ < end_ && *cursor_ != ',' && *cursor_ != '\n') ++cursor_;
+        const char* stop = cursor_;
+        if (stop > start && stop[-1] == '\r') --stop;
+        field.append(start, stop);
+
+        if (cursor_ < end_ && *cursor_ == ',') {
+            ++cursor_;
+            continue;
+        }
+        if (cursor_ < end_) { // Line break ends the record
+            ++cursor_;
+            ++line_;
+        }
+        break;
+    }
+    fields.resize(count);
+    return true;
+}
+
+static bool needs_quoting(char c) {
+    return c == ',' || c == '"' || c == '\r' || c == '\n';
+}
+
+void append_csv_field(std::string& out, const char* field, size_t length) {
+    if (std::find_if(field, field + length, needs_quoting) == field + length) {
+        out.append(field, length);
+        return;
+    }
+    out += '"';
+    for (size_t i = 0; i < length; ++i) {
+        if (field[i] == '"') out += '"';
+        out += field[i];
+    }
+    out += '"';
+}
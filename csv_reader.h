@@ -0,0 +1,35 @@
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// --- Streaming CSV reader over an in-memory file ---
+// Used by the batch commands (cli.h) on top of MappedFile, so an import of any
+// size costs one pass over the bytes and no per-row allocation once the field
+// strings have grown. Follows RFC 4180: fields are comma-separated, may be
+// wrapped in double quotes, and a quoted field may contain commas, newlines
+// and doubled quotes (""). Blank lines are skipped and a '\r' before a line
+// break is dropped.
+class CsvReader {
+public:
+    CsvReader(const char* data, size_t size) : cursor_(data), end_(data + size), line_(1), record_line_(0) {}
+
+    // Next record split into `fields` (resized to the field count). False at the end.
+    bool next_record(std::vector<std::string>& fields);
+    // 1-based line where the record last returned started, for error reports.
+    size_t line_number() const { return record_line_; }
+
+private:
+    const char* cursor_;
+    const char* end_;
+    size_t line_;
+    size_t record_line_;
+};
+
+// Appends `field` to `out`, quoting it only if it holds a comma, quote or line break.
+void append_csv_field(std::string& out, const char* field, size_t length);
+inline void append_csv_field(std::string& out, const std::string& field) { append_csv_field(out, field.data(), field.size()); }
+
+#endif // CSV_READER_H
@@ -1,320 +1,963 @@
-#include "file_handler.h"
-#include "scheduler_planner.h" // For ClassDetails, TaskDetails definitions
-#include "study_hub.h"         // For Deck, Card, Note, Notebook definitions
-#include <limits>              // Required for std::numeric_limits by load functions
-
-// Define file constants
-const std::string FLASHCARDS_FILE = "flashcards.dat";
-const std::string NOTEBOOKS_FILE = "notebooks.dat";
-const std::string NOTE_CONTENT_START_DELIMITER = "---CONTENT_START---";
-const std::string NOTE_CONTENT_END_DELIMITER = "---CONTENT_END---";
-const std::string CLASS_SCHEDULE_FILE = "schedule.dat";
-const std::string TASKS_FILE = "tasks.dat";
-
-lementations for Scheduler and Tasks ---
-
-void saveClassScheduleToFile() {
-    std::ofstream outfile(CLASS_SCHEDULE_FILE);
-    if (!outfile) {
-        std::cerr << "Error: Could not open " << CLASS_SCHEDULE_FILE << " for writing." << std::endl;
-        return;
-    }
-
-    outfile << classSchedule.size() << std::endl;
-    for (const auto& cls : classSchedule) {
-        outfile << cls.subject << std::endl;
-        outfile << cls.startTime << std::endl;
-        outfile << cls.endTime << std::endl;
-        outfile << cls.venue << std::endl;
-        outfile << cls.daysOfWeek.size() << std::endl;
-        for (const auto& day : cls.daysOfWeek) {
-            outfile << day << std::endl;
-        }
-    }
-    outfile.close();
-}
-
-void loadClassScheduleFromFile() {
-    std::ifstream infile(CLASS_SCHEDULE_FILE);
-    if (!infile) {
-        // std::cerr << "Info: " << CLASS_SCHEDULE_FILE << " not found. Starting with an empty schedule." << std::endl;
-        return;
-    }
-
-    classSchedule.clear();
-    size_t numClasses;
-    infile >> numClasses;
-    if (infile.fail()) {
-        classSchedule.clear();
-        infile.close();
-        return;
-    }
-    infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-    for (size_t i = 0; i < numClasses; ++i) {
-        ClassDetails currentClass;
-        if (!std::getline(infile, currentClass.subject) ||
-            !std::getline(infile, currentClass.startTime) ||
-            !std::getline(infile, currentClass.endTime) ||
-            !std::getline(infile, currentClass.venue)) {
-            classSchedule.clear();
-            infile.close();
-            return;
-        }
-
-        size_t numDays;
-        infile >> numDays;
-        if (infile.fail()) {
-            classSchedule.clear();
-            infile.close();
-            return;
-        }
-        infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-        currentClass.daysOfWeek.clear();
-        for (size_t j = 0; j < numDays; ++j) {
-            std::string day;
-            if (!std::getline(infile, day)) {
-                classSchedule.clear();
-                infile.close();
-                return;
-            }
-            currentClass.daysOfWeek.push_back(day);
-        }
-        classSchedule.push_back(currentClass);
-    }
-    infile.close();
-}
-
-void saveTasksToFile() {
-    std::ofstream outfile(TASKS_FILE);
-    if (!outfile) {
-        std::cerr << "Error: Could not open " << TASKS_FILE << " for writing." << std::endl;
-        return;
-    }
-
-    outfile << tasks.size() << std::endl;
-    for (const auto& task : tasks) {
-        outfile << task.name << std::endl;
-        outfile << task.subject << std::endl;
-        std::string tempInfos = task.infos;
-        std::replace(tempInfos.begin(), tempInfos.end(), '\n', ' ');
-        outfile << tempInfos << std::endl;
-        outfile << task.deadlineDate << std::endl;
-        outfile << task.urgency << std::endl;
-        outfile << task.completed << std::endl;
-    }
-    outfile.close();
-}
-
-void loadTasksFromFile() {
-    std::ifstream infile(TASKS_FILE);
-    if (!infile) {
-        return;
-    }
-
-    tasks.clear();
-    size_t numTasks;
-    infile >> numTasks;
-    if (infile.fail()) {
-        tasks.clear();
-        infile.close();
-        return;
-    }
-    infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-    for (size_t i = 0; i < numTasks; ++i) {
-        TaskDetails currentTask;
-        if (!std::getline(infile, currentTask.name) ||
-            !std::getline(infile, currentTask.subject) ||
-            !std::getline(infile, currentTask.infos) ||
-            !std::getline(infile, currentTask.deadlineDate) ||
-            !(infile >> currentTask.urgency) ||
-            !(infile >> currentTask.completed)) {
-            tasks.clear();
-            infile.close();
-            return;
-        }
-        infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        tasks.push_back(currentTask);
-    }
-    infile.close();
-}
-
-// --- File Handling Implementations for Study Hub ---
-
-void save_flashcards_to_file() {
-    std::ofstream outfile(FLASHCARDS_FILE);
-    if (!outfile) {
-        std::cerr << "Error: Could not open " << FLASHCARDS_FILE << " for writing." << std::endl;
-        return;
-    }
-
-    outfile << flashcard_decks.size() << std::endl;
-    for (const auto& deck : flashcard_decks) {
-        outfile << deck.subject << std::endl;
-        outfile << deck.title << std::endl;
-        outfile << deck.timestamp << std::endl;
-        outfile << deck.cards.size() << std::endl;
-
-        for (const auto& card : deck.cards) {
-            outfile << card.type << std::endl;
-            outfile << card.question << std::endl;
-            outfile << card.answer << std::endl;
-            if (card.type == "multiple_choice") {
-                outfile << card.options.size() << std::endl;
-                for (const auto& option : card.options) {
-                    outfile << option << std::endl;
-                }
-            }
-        }
-    }
-    outfile.close();
-}
-
-void load_flashcards_from_file() {
-    std::ifstream infile(FLASHCARDS_FILE);
-    if (!infile) {
-        return;
-    }
-
-    int num_decks; // Matching original type, though size_t might be more consistent
-    infile >> num_decks;
-    infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-    if (infile.fail() || num_decks < 0) {
-        flashcard_decks.clear(); // Ensure clear on corruption
-        infile.close();
-        return;
-    }
-
-    flashcard_decks.clear();
-    for (int i = 0; i < num_decks; ++i) {
-        Deck current_deck;
-        if (!std::getline(infile, current_deck.subject) ||
-            !std::getline(infile, current_deck.title) ||
-            !std::getline(infile, current_deck.timestamp)) {
-            flashcard_decks.clear(); infile.close(); return; // Corruption
-        }
-
-        int num_cards;
-        infile >> num_cards;
-        infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        if (infile.fail() || num_cards < 0) { flashcard_decks.clear(); infile.close(); return; }
-
-
-        for (int j = 0; j < num_cards; ++j) {
-            Card current_card;
-            if (!std::getline(infile, current_card.type) ||
-                !std::getline(infile, current_card.question) ||
-                !std::getline(infile, current_card.answer)) {
-                 flashcard_decks.clear(); infile.close(); return;
-            }
-
-            if (current_card.type == "multiple_choice") {
-                int num_options;
-                infile >> num_options;
-                infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                if (infile.fail() || num_options < 0) { flashcard_decks.clear(); infile.close(); return; }
-
-                for (int k = 0; k < num_options; ++k) {
-                    std::string option;
-                    if (!std::getline(infile, option)) { flashcard_decks.clear(); infile.close(); return;}
-                    current_card.options.push_back(option);
-                }
-            }
-            current_deck.cards.push_back(current_card);
-        }
-        flashcard_decks.push_back(current_deck);
-    }
-    infile.close();
-}
-
-void save_notebooks_to_file() {
-    std::ofstream outfile(NOTEBOOKS_FILE);
-    if (!outfile) {
-        std::cerr << "Error: Could not open " << NOTEBOOKS_FILE << " for writing." << std::endl;
-        return;
-    }
-
-    outfile << notebooks.size() << std::endl;
-    for (const auto& notebook : notebooks) {
-        outfile << notebook.subject << std::endl;
-        outfile << notebook.notes.size() << std::endl;
-
-        for (const auto& note : notebook.notes) {
-            outfile << note.topic_title << std::endl;
-            outfile << note.timestamp << std::endl;
-            outfile << NOTE_CONTENT_START_DELIMITER << std::endl;
-            outfile << note.content << std::endl; // Assuming content does not contain NOTE_CONTENT_END_DELIMITER internally
-            outfile << NOTE_CONTENT_END_DELIMITER << std::endl;
-        }
-    }
-    outfile.close();
-}
-
-void load_notebooks_from_file() {
-    std::ifstream infile(NOTEBOOKS_FILE);
-    if (!infile) {
-        return;
-    }
-
-    int num_notebooks; // Matching original type
-    infile >> num_notebooks;
-    infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-    if (infile.fail() || num_notebooks < 0) {
-        notebooks.clear(); // Ensure clear on corruption
-        infile.close();
-        return;
-    }
-
-    notebooks.clear();
-    for (int i = 0; i < num_notebooks; ++i) {
-        Notebook current_notebook;
-        if (!std::getline(infile, current_notebook.subject)) {
-            notebooks.clear(); infile.close(); return;
-        }
-
-        int num_notes;
-        infile >> num_notes;
-        infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        if (infile.fail() || num_notes < 0) { notebooks.clear(); infile.close(); return; }
-
-        for (int j = 0; j < num_notes; ++j) {
-            Note current_note;
-            if (!std::getline(infile, current_note.topic_title) ||
-                !std::getline(infile, current_note.timestamp)) {
-                 notebooks.clear(); infile.close(); return;
-            }
-
-            std::string delimiter_check;
-            if (!std::getline(infile, delimiter_check) || delimiter_check != NOTE_CONTENT_START_DELIMITER) {
-                 notebooks.clear(); infile.close(); return;
-            }
-
-            std::string line;
-            current_note.content = "";
-            while (std::getline(infile, line)) {
-                if (line == NOTE_CONTENT_END_DELIMITER) {
-                    break;
-                }
-                current_note.content += line + "\n";
-            }
-            // Remove trailing newline if content is not empty and loop broke on delimiter
-            if (!current_note.content.empty() && line == NOTE_CONTENT_END_DELIMITER) {
-                 // current_note.content.pop_back(); // Remove last '\n'
-                 // Corrected logic:
-                 if (current_note.content.length() > 0 && current_note.content.back() == '\n') {
-                    current_note.content.pop_back();
-                 }
-            } else if (line != NOTE_CONTENT_END_DELIMITER) { // File ended unexpectedly
-                 notebooks.clear(); infile.close(); return;
-            }
-
-            current_notebook.notes.push_back(current_note);
-        }
-        notebooks.push_back(current_notebook);
-    }
-    infile.close();
-}
+#include "file_handler.h"
+#include "scheduler_core.h"    // For ClassDetails, TaskDetails definitions
+#include "study_core.h"        // For Deck, Card, Note, Notebook definitions
+#include "term_calendar.h"     // For termCalendar
+#include "journal.h"           // For append-only operation journals
+#include "note_search.h"       // For rebuilding note_search_index after a load
+#include "subject_registry.h"  // For rebuilding subject_registry after a load
+#include "spaced_repetition.h" // For reset_due_index after loading card memory
+#include "mapped_file.h"       // Snapshots are mapped, not streamed, when loading
+#include "line_reader.h"       // For LineReader over the mapped snapshots
+#include "atomic_file.h"       // Snapshots are replaced with write-temp/fsync/rename
+#include "flashcard_binary.h"  // flashcards.bin is read instead of the text snapshot it mirrors
+#include "utils.h"             // For time and weekday conversions
+#include <limits>              // Required for std::numeric_limits by load functions
+#include <sstream>             // For parsing journaled indices
+#include <cstdlib>             // For std::atoi
+#include <sys/stat.h>          // For stat() in on-disk change detection
+#include <map>                 // For matching saved card memory to decks
+#include <cstdio>              // For std::snprintf
+#include <cstring>             // For std::memcpy
+
+// Define file constants
+const std::string FLASHCARDS_FILE = "flashcards.dat";
+const std::string NOTEBOOKS_FILE = "notebooks.dat";
+const std::string NOTE_CONTENT_START_DELIMITER = "---CONTENT_START---";
+const std::string NOTE_CONTENT_END_DELIMITER = "---CONTENT_END---";
+const std::string CLASS_SCHEDULE_FILE = "schedule.dat";
+const std::string TASKS_FILE = "tasks.dat";
+const std::string FLASHCARDS_JOURNAL_FILE = "flashcards.journal";
+const std::string FLASHCARDS_BINARY_FILE = "flashcards.bin";
+const std::string NOTEBOOKS_JOURNAL_FILE = "notebooks.journal";
+const std::string FLASHCARD_MEMORY_FILE = "flashcards_srs.dat";
+const std::string CLASS_SCHEDULE_JOURNAL_FILE = "schedule.journal";
+const std::string TASKS_JOURNAL_FILE = "tasks.journal";
+const std::string TERM_CALENDAR_FILE = "term.dat";
+
+// --- File Handling Implementations for Scheduler and Tasks ---
+
+void saveClassScheduleToFile() {
+    std::string buffer;
+    buffer.reserve(16 + classSchedule.size() * 96);
+    buffer += std::to_string(classSchedule.size()) + '\n';
+    for (const auto& cls : classSchedule) {
+        buffer += cls.subject + '\n';
+        buffer += classTimeText(cls.startMinutes, cls.unparsedStart) + '\n';
+        buffer += classTimeText(cls.endMinutes, cls.unparsedEnd) + '\n';
+        buffer += cls.venue + '\n';
+        // Days stay as one readable name per line so older files keep loading unchanged
+        buffer += std::to_string(countDays(cls.dayMask)) + '\n';
+        for (int d = 1; d <= 7; ++d) { // Monday first
+            if (cls.dayMask & (1u << (d % 7))) {
+                buffer += dayIndexToName(d % 7);
+                buffer += '\n';
+            }
+        }
+    }
+    if (write_file_atomically(CLASS_SCHEDULE_FILE, buffer)) { // From atomic_file.h
+        truncate_journal(CLASS_SCHEDULE_JOURNAL_FILE, snapshot_id(buffer.data(), buffer.size())); // Snapshot now contains every journaled operation
+    }
+}
+
+// Parses a schedule snapshot into classSchedule. Returns false on corruption.
+// Like the other snapshot readers it builds records in place in the global vector.
+static bool readClassScheduleSnapshot(const MappedFile& snapshot) {
+    LineReader reader(snapshot.data(), snapshot.size());
+    long long numClasses;
+    if (!reader.next_int(numClasses) || numClasses < 0) {
+        return false;
+    }
+    // Every class takes at least five lines, which bounds a sane reservation.
+    classSchedule.reserve(static_cast<size_t>(std::min<long long>(numClasses, reader.remaining() / 5 + 1)));
+
+    const char* line;
+    size_t length;
+    for (long long i = 0; i < numClasses; ++i) {
+        classSchedule.emplace_back(); // Filled in place
+        ClassDetails& currentClass = classSchedule.back();
+        if (!reader.next_string(currentClass.subject) || !reader.next_line(line, length)) {
+            return false;
+        }
+        currentClass.startMinutes = parseTimeToMinutes(line, length); // Parsed once here; -1 if the file holds a bad time
+        if (currentClass.startMinutes == -1) currentClass.unparsedStart.assign(line, length);
+        if (!reader.next_line(line, length)) {
+            return false;
+        }
+        currentClass.endMinutes = parseTimeToMinutes(line, length);
+        if (currentClass.endMinutes == -1) currentClass.unparsedEnd.assign(line, length);
+        if (!reader.next_string(currentClass.venue)) {
+            return false;
+        }
+
+        long long numDays;
+        if (!reader.next_int(numDays) || numDays < 0) {
+            return false;
+        }
+        currentClass.dayMask = 0;
+        for (long long j = 0; j < numDays; ++j) {
+            if (!reader.next_line(line, length)) {
+                return false;
+            }
+            int d = dayTokenToIndex(line, length);
+            if (d != -1) currentClass.dayMask |= static_cast<unsigned char>(1u << d);
+        }
+    }
+    return true;
+}
+
+// Journal fields for a class: subject, start, end, venue, comma-separated days.
+static void appendClassFields(JournalRecord& record, const ClassDetails& cls) {
+    record.fields.push_back(cls.subject);
+    record.fields.push_back(classTimeText(cls.startMinutes, cls.unparsedStart));
+    record.fields.push_back(classTimeText(cls.endMinutes, cls.unparsedEnd));
+    record.fields.push_back(cls.venue);
+    record.fields.push_back(dayMaskToString(cls.dayMask));
+}
+
+static bool classFromFields(const std::vector<std::string>& fields, size_t first, ClassDetails& cls) {
+    if (fields.size() < first + 5) return false;
+    cls.subject = fields[first];
+    cls.startMinutes = timeToMinutes(fields[first + 1]);
+    cls.endMinutes = timeToMinutes(fields[first + 2]);
+    if (cls.startMinutes == -1) cls.unparsedStart = fields[first + 1];
+    if (cls.endMinutes == -1) cls.unparsedEnd = fields[first + 2];
+    cls.venue = fields[first + 3];
+    return parseDaysOfWeek(fields[first + 4], cls.dayMask);
+}
+
+// Parses a non-negative index field; returns false if it is malformed or >= limit.
+static bool indexFromField(const std::string& field, size_t limit, size_t& index) {
+    if (field.empty() || field.find_first_not_of("0123456789") != std::string::npos) return false;
+    std::stringstream ss(field);
+    ss >> index;
+    return !ss.fail() && index < limit;
+}
+
+static bool applyClassJournalRecord(const JournalRecord& record) {
+    ClassDetails cls;
+    if (record.op == "ADD") {
+        if (!classFromFields(record.fields, 0, cls)) return false;
+        classSchedule.push_back(cls);
+        return true;
+    }
+    if (record.op == "EDIT") {
+        size_t index;
+        if (record.fields.empty() || !indexFromField(record.fields[0], classSchedule.size(), index) ||
+            !classFromFields(record.fields, 1, cls)) return false;
+        classSchedule[index] = cls;
+        return true;
+    }
+    return false; // Unknown operation
+}
+
+void loadClassScheduleFromFile() {
+    classSchedule.clear();
+    MappedFile snapshot;
+    bool corrupt = snapshot.open(CLASS_SCHEDULE_FILE) && !readClassScheduleSnapshot(snapshot);
+    uint64_t snapshotId = snapshot_id(snapshot.data(), snapshot.size()); // Matched against the journal's BASE
+    snapshot.close(); // Everything was copied out; release the mapping before any compaction rewrites the file
+    if (corrupt) {
+        classSchedule.clear(); // Corrupt snapshot; journal entries can't be applied on top of it either
+    } else {
+        replay_journal(CLASS_SCHEDULE_JOURNAL_FILE, snapshotId, applyClassJournalRecord);
+        if (journal_needs_compaction(CLASS_SCHEDULE_JOURNAL_FILE)) {
+            saveClassScheduleToFile();
+        }
+    }
+    rebuildClassConflictIndex(); // Keep the per-weekday conflict index in sync with the loaded schedule
+    rebuild_class_subjects();
+}
+
+// term.dat: first and last day ("----------" if unset), then the holiday count
+// followed by a date line and a name line per holiday, then the make-up day
+// count followed by a date line and the followed weekday's name per make-up day.
+void saveTermCalendarToFile() {
+    std::string buffer;
+    buffer += termCalendar.firstDay.toString() + '\n';
+    buffer += termCalendar.lastDay.toString() + '\n';
+    buffer += std::to_string(termCalendar.holidays.size()) + '\n';
+    for (const auto& holiday : termCalendar.holidays) {
+        buffer += holiday.date.toString() + '\n';
+        buffer += holiday.name + '\n';
+    }
+    buffer += std::to_string(termCalendar.makeUpDays.size()) + '\n';
+    for (const auto& makeUp : termCalendar.makeUpDays) {
+        buffer += makeUp.date.toString() + '\n';
+        buffer += dayIndexToName(makeUp.followsWeekday);
+        buffer += '\n';
+    }
+    write_file_atomically(TERM_CALENDAR_FILE, buffer);
+}
+
+// Parses term.dat into termCalendar. Returns false on corruption.
+static bool readTermCalendarSnapshot(const MappedFile& snapshot) {
+    LineReader reader(snapshot.data(), snapshot.size());
+    const char* line;
+    size_t length;
+    if (!reader.next_line(line, length)) return false;
+    termCalendar.firstDay = CivilDate::parse(line, length); // "----------" reads back as unset
+    if (!reader.next_line(line, length)) return false;
+    termCalendar.lastDay = CivilDate::parse(line, length);
+
+    long long count;
+    if (!reader.next_int(count) || count < 0) return false;
+    std::string name;
+    for (long long i = 0; i < count; ++i) {
+        if (!reader.next_line(line, length)) return false;
+        CivilDate day = CivilDate::parse(line, length);
+        if (!reader.next_string(name) || !day.isValid()) return false;
+        termCalendar.setHoliday(day, name); // Keeps them sorted even if the file was edited by hand
+    }
+    if (!reader.next_int(count) || count < 0) return false;
+    for (long long i = 0; i < count; ++i) {
+        if (!reader.next_line(line, length)) return false;
+        CivilDate day = CivilDate::parse(line, length);
+        if (!reader.next_line(line, length) || !day.isValid()) return false;
+        int weekday = dayTokenToIndex(line, length);
+        if (weekday == -1) return false;
+        termCalendar.setMakeUpDay(day, weekday);
+    }
+    return true;
+}
+
+void loadTermCalendarFromFile() {
+    termCalendar.clear();
+    MappedFile snapshot;
+    if (snapshot.open(TERM_CALENDAR_FILE) && !readTermCalendarSnapshot(snapshot)) {
+        termCalendar.clear(); // Corrupt: fall back to no term, so classes still show every week
+    }
+}
+
+void journalClassAdded(const ClassDetails& cls) {
+    JournalRecord record;
+    record.op = "ADD";
+    appendClassFields(record, cls);
+    if (!append_journal_record(CLASS_SCHEDULE_JOURNAL_FILE, record) ||
+        journal_needs_compaction(CLASS_SCHEDULE_JOURNAL_FILE)) {
+        saveClassScheduleToFile(); // Fall back to (or compact into) a full snapshot
+    }
+}
+
+void journalClassEdited(size_t classIndex, const ClassDetails& cls) {
+    JournalRecord record;
+    record.op = "EDIT";
+    record.fields.push_back(std::to_string(classIndex));
+    appendClassFields(record, cls);
+    if (!append_journal_record(CLASS_SCHEDULE_JOURNAL_FILE, record) ||
+        journal_needs_compaction(CLASS_SCHEDULE_JOURNAL_FILE)) {
+        saveClassScheduleToFile();
+    }
+}
+
+void saveTasksToFile() {
+    size_t size = 16;
+    for (const auto& task : tasks) {
+        if (task.removed) continue;
+        size += task.name.size + task.subject.size() + task.infos.size + CIVIL_DATE_LENGTH + 16;
+    }
+    std::string buffer;
+    buffer.reserve(size);
+
+    buffer += std::to_string(taskCount()) + '\n';
+    for (const auto& task : tasks) {
+        if (task.removed) continue;
+        buffer.append(task.name.data, task.name.size) += '\n';
+        buffer += task.subject + '\n';
+        size_t infos_start = buffer.size();
+        buffer.append(task.infos.data, task.infos.size);
+        std::replace(buffer.begin() + infos_start, buffer.end(), '\n', ' '); // Infos must stay on one line
+        buffer += '\n';
+        if (!task.deadline.isValid() && !task.unparsedDeadline.empty()) {
+            buffer.append(task.unparsedDeadline.data, task.unparsedDeadline.size) += '\n';
+        } else {
+            char deadline[CIVIL_DATE_LENGTH];
+            task.deadline.format(deadline);
+            buffer.append(deadline, CIVIL_DATE_LENGTH) += '\n';
+        }
+        buffer += std::to_string(task.urgency) + '\n';
+        buffer += task.completed ? "1\n" : "0\n";
+    }
+    if (write_file_atomically(TASKS_FILE, buffer)) {
+        truncate_journal(TASKS_JOURNAL_FILE, snapshot_id(buffer.data(), buffer.size()));
+        compactTasks(); // The next journal's indices count from the snapshot just written
+    }
+}
+
+// Parses a tasks snapshot into tasks. Returns false on corruption.
+static bool readTasksSnapshot(const MappedFile& snapshot) {
+    LineReader reader(snapshot.data(), snapshot.size());
+    long long numTasks;
+    if (!reader.next_int(numTasks) || numTasks < 0) {
+        return false;
+    }
+    // Every task takes six lines, which bounds a sane reservation.
+    tasks.reserve(static_cast<size_t>(std::min<long long>(numTasks, reader.remaining() / 6 + 1)));
+
+    const char* name;
+    const char* infos;
+    const char* deadline;
+    size_t nameLength, infosLength, deadlineLength;
+    for (long long i = 0; i < numTasks; ++i) {
+        tasks.emplace_back(); // Filled in place
+        TaskDetails& currentTask = tasks.back();
+        long long urgency, completed;
+        if (!reader.next_line(name, nameLength) ||
+            !reader.next_string(currentTask.subject) ||
+            !reader.next_line(infos, infosLength) ||
+            !reader.next_line(deadline, deadlineLength) ||
+            !reader.next_int(urgency) ||
+            !reader.next_int(completed) || (completed != 0 && completed != 1)) {
+            return false;
+        }
+        currentTask.name = tasksArena.copy(name, nameLength); // The mapping is closed after loading
+        currentTask.infos = tasksArena.copy(infos, infosLength);
+        // Older versions saved whatever was typed; a malformed deadline loads as invalid
+        // ("----------"), which sorts after every date, as it already did in the index.
+        // Its text is kept so saving doesn't overwrite what the user wrote.
+        currentTask.deadline = CivilDate::parse(deadline, deadlineLength);
+        if (!currentTask.deadline.isValid()) currentTask.unparsedDeadline = tasksArena.copy(deadline, deadlineLength);
+        currentTask.urgency = static_cast<int>(urgency);
+        currentTask.completed = completed == 1;
+    }
+    return true;
+}
+
+static bool applyTaskJournalRecord(const JournalRecord& record) {
+    if (record.op == "ADD") {
+        if (record.fields.size() != 6) return false;
+        TaskDetails task;
+        task.name = tasksArena.copy(record.fields[0]);
+        task.subject = record.fields[1];
+        task.infos = tasksArena.copy(record.fields[2]);
+        task.deadline = CivilDate::parse(record.fields[3]);
+        if (!task.deadline.isValid()) task.unparsedDeadline = tasksArena.copy(record.fields[3]);
+        task.urgency = std::atoi(record.fields[4].c_str());
+        task.completed = record.fields[5] == "1";
+        appendTask(task);
+        return true;
+    }
+    size_t index;
+    if (record.fields.size() != 1 || !indexFromField(record.fields[0], tasks.size(), index) ||
+        tasks[index].removed) {
+        return false;
+    }
+    if (record.op == "COMPLETE") {
+        completeTaskAt(index);
+        return true;
+    }
+    if (record.op == "REMOVE") {
+        removeTaskAt(index); // Same order-preserving removal the menu performed
+        return true;
+    }
+    return false; // Unknown operation
+}
+
+void loadTasksFromFile() {
+    clearTasks();
+    MappedFile snapshot;
+    bool corrupt = snapshot.open(TASKS_FILE) && !readTasksSnapshot(snapshot);
+    uint64_t snapshotId = snapshot_id(snapshot.data(), snapshot.size());
+    snapshot.close();
+    if (corrupt) {
+        clearTasks();
+        rebuildTaskPriorityIndex();
+        rebuild_task_subjects();
+    } else {
+        rebuildTaskPriorityIndex(); // Journal replay goes through the index-maintaining task mutations
+        rebuild_task_subjects();
+        replay_journal(TASKS_JOURNAL_FILE, snapshotId, applyTaskJournalRecord);
+        if (journal_needs_compaction(TASKS_JOURNAL_FILE)) {
+            saveTasksToFile();
+        }
+    }
+}
+
+// Appends `record` to the tasks journal, compacting into tasks.dat when due.
+static void appendTaskJournalRecord(const JournalRecord& record) {
+    if (!append_journal_record(TASKS_JOURNAL_FILE, record) || journal_needs_compaction(TASKS_JOURNAL_FILE)) {
+        saveTasksToFile();
+    }
+}
+
+void journalTaskAdded(const TaskDetails& task) {
+    JournalRecord record;
+    record.op = "ADD";
+    std::string tempInfos = task.infos.str();
+    std::replace(tempInfos.begin(), tempInfos.end(), '\n', ' '); // Same normalization as the snapshot
+    record.fields.push_back(task.name.str());
+    record.fields.push_back(task.subject);
+    record.fields.push_back(tempInfos);
+    record.fields.push_back(taskDeadlineText(task));
+    record.fields.push_back(std::to_string(task.urgency));
+    record.fields.push_back(task.completed ? "1" : "0");
+    appendTaskJournalRecord(record);
+}
+
+void journalTaskCompleted(size_t taskIndex) {
+    JournalRecord record;
+    record.op = "COMPLETE";
+    record.fields.push_back(std::to_string(taskIndex));
+    appendTaskJournalRecord(record);
+}
+
+void journalTaskDeleted(size_t taskIndex) {
+    JournalRecord record;
+    record.op = "REMOVE";
+    record.fields.push_back(std::to_string(taskIndex));
+    appendTaskJournalRecord(record);
+}
+
+// --- File Handling Implementations for Study Hub ---
+
+// --- On-disk change detection for the resident Study Hub stores ---
+// A store is reloaded only if its snapshot or journal differs from what this
+// process last read or wrote.
+struct FileSignature {
+    bool exists;
+    long long size;
+    long long mtime_ns;
+
+    bool operator==(const FileSignature& other) const {
+        return exists == other.exists && size == other.size && mtime_ns == other.mtime_ns;
+    }
+};
+
+static FileSignature read_file_signature(const std::string& path) {
+    FileSignature signature = {false, 0, 0};
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0) {
+        signature.exists = true;
+        signature.size = static_cast<long long>(st.st_size);
+#if defined(__linux__)
+        signature.mtime_ns = static_cast<long long>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#elif defined(__APPLE__)
+        signature.mtime_ns = static_cast<long long>(st.st_mtimespec.tv_sec) * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+        signature.mtime_ns = static_cast<long long>(st.st_mtime) * 1000000000LL;
+#endif
+    }
+    return signature;
+}
+
+static FileSignature flashcards_signatures[2]; // snapshot, journal
+static FileSignature notebooks_signatures[2];
+
+static void remember_flashcards_signature() {
+    flashcards_signatures[0] = read_file_signature(FLASHCARDS_FILE);
+    flashcards_signatures[1] = read_file_signature(FLASHCARDS_JOURNAL_FILE);
+}
+
+static void remember_notebooks_signature() {
+    notebooks_signatures[0] = read_file_signature(NOTEBOOKS_FILE);
+    notebooks_signatures[1] = read_file_signature(NOTEBOOKS_JOURNAL_FILE);
+}
+
+bool flashcards_changed_on_disk() {
+    return !(read_file_signature(FLASHCARDS_FILE) == flashcards_signatures[0]) ||
+           !(read_file_signature(FLASHCARDS_JOURNAL_FILE) == flashcards_signatures[1]);
+}
+
+bool notebooks_changed_on_disk() {
+    return !(read_file_signature(NOTEBOOKS_FILE) == notebooks_signatures[0]) ||
+           !(read_file_signature(NOTEBOOKS_JOURNAL_FILE) == notebooks_signatures[1]);
+}
+
+// Builds a deck or notebook snapshot: a count line, then each record's text. Clean
+// records copy their bytes from `previous` (the snapshot they were loaded from or
+// last saved to) when it is still that file; the rest are serialized. `ranges`
+// receives each record's place in the new snapshot, to be applied once it is written.
+template <typename Record, typename Serialize>
+static void build_record_snapshot(const std::vector<Record>& records, const MappedFile& previous,
+                                  Serialize serialize, std::string& buffer,
+                                  std::vector<std::pair<size_t, size_t> >& ranges) {
+    buffer += std::to_string(records.size()) + '\n';
+    ranges.clear();
+    ranges.reserve(records.size());
+    for (const auto& record : records) {
+        size_t offset = buffer.size();
+        if (!record.dirty && previous.is_open() && record.snapshot_offset <= previous.size() &&
+            record.snapshot_length <= previous.size() - record.snapshot_offset) {
+            buffer.append(previous.data() + record.snapshot_offset, record.snapshot_length);
+            if (record.snapshot_length > 0 && buffer[buffer.size() - 1] != '\n') {
+                buffer += '\n'; // The old file's last line had no terminator
+            }
+        } else {
+            serialize(record, buffer);
+        }
+        ranges.push_back(std::make_pair(offset, buffer.size() - offset));
+    }
+}
+
+template <typename Record>
+static void apply_record_ranges(std::vector<Record>& records, const std::vector<std::pair<size_t, size_t> >& ranges) {
+    for (size_t i = 0; i < records.size(); ++i) {
+        records[i].snapshot_offset = ranges[i].first;
+        records[i].snapshot_length = ranges[i].second;
+        records[i].dirty = false;
+    }
+}
+
+// Maps the snapshot at `path` for build_record_snapshot, unless it changed since it was last loaded or saved.
+static void open_previous_snapshot(MappedFile& previous, const std::string& path, const FileSignature& remembered) {
+    if (remembered.exists && read_file_signature(path) == remembered) {
+        previous.open(path);
+    }
+}
+
+// Appends the .dat text of one deck to `out`.
+static void serialize_deck_text(const Deck& deck, std::string& out) {
+    out += deck.subject + '\n';
+    out += deck.title + '\n';
+    out += deck.timestamp + '\n';
+    out += std::to_string(deck.cards.size()) + '\n';
+
+    for (const auto& card : deck.cards) {
+        out += card.type_name();
+        out += '\n';
+        StringRef question = card.question(), answer = card.answer();
+        out.append(question.data, question.size) += '\n';
+        out.append(answer.data, answer.size) += '\n';
+        if (card.type() == CARD_MULTIPLE_CHOICE) {
+            size_t count = card.option_count();
+            out += std::to_string(count) + '\n';
+            for (size_t k = 0; k < count; ++k) {
+                StringRef option = card.option(k);
+                out.append(option.data, option.size) += '\n';
+            }
+        }
+    }
+}
+
+bool read_flashcards_text(const char* data, size_t size, std::vector<Deck>& decks) {
+    decks.clear();
+    LineReader reader(data, size);
+
+    long long num_decks;
+    if (!reader.next_int(num_decks) || num_decks < 0) {
+        return false;
+    }
+    decks.reserve(static_cast<size_t>(std::min<long long>(num_decks, reader.remaining() / 4 + 1)));
+
+    for (long long i = 0; i < num_decks; ++i) {
+        decks.emplace_back(); // Filled in place
+        Deck& current_deck = decks.back();
+        const char* deck_begin = reader.position();
+        long long num_cards;
+        if (!reader.next_string(current_deck.subject) ||
+            !reader.next_string(current_deck.title) ||
+            !reader.next_string(current_deck.timestamp) ||
+            !reader.next_int(num_cards) || num_cards < 0) {
+            return false; // Corruption
+        }
+        current_deck.cards.reserve(static_cast<size_t>(std::min<long long>(num_cards, reader.remaining() / 3 + 1)));
+
+        // Lines are copied straight from the snapshot into the deck's text arena
+        const char* type;
+        const char* question;
+        const char* answer;
+        size_t type_length, question_length, answer_length;
+        for (long long j = 0; j < num_cards; ++j) {
+            if (!reader.next_line(type, type_length) ||
+                !reader.next_line(question, question_length) ||
+                !reader.next_line(answer, answer_length)) {
+                 return false;
+            }
+            CardType card_type = card_type_from_name(type, type_length);
+            current_deck.cards.push_back(card_type, question, question_length, answer, answer_length);
+
+            if (card_type == CARD_MULTIPLE_CHOICE) {
+                long long num_options;
+                if (!reader.next_int(num_options) || num_options < 0) { return false; }
+                const char* option;
+                size_t option_length;
+                for (long long k = 0; k < num_options; ++k) {
+                    if (!reader.next_line(option, option_length)) { return false; }
+                    current_deck.cards.push_option(option, option_length);
+                }
+            }
+        }
+        // A save can copy these bytes back unchanged while the deck stays clean
+        current_deck.snapshot_offset = static_cast<size_t>(deck_begin - data);
+        current_deck.snapshot_length = static_cast<size_t>(reader.position() - deck_begin);
+        current_deck.dirty = false;
+    }
+    return true;
+}
+
+bool save_flashcards_to_file() {
+    // Only decks changed since the last save are re-serialized; the rest are copied from the old snapshot.
+    std::string buffer;
+    std::vector<std::pair<size_t, size_t> > ranges;
+    {
+        MappedFile previous;
+        open_previous_snapshot(previous, FLASHCARDS_FILE, flashcards_signatures[0]);
+        buffer.reserve(previous.size() + 16);
+        build_record_snapshot(flashcard_decks, previous, serialize_deck_text, buffer, ranges);
+    }
+    bool written = write_file_atomically(FLASHCARDS_FILE, buffer);
+    if (written) {
+        apply_record_ranges(flashcard_decks, ranges);
+        std::remove(FLASHCARDS_BINARY_FILE.c_str()); // It mirrors the snapshot just replaced
+        truncate_journal(FLASHCARDS_JOURNAL_FILE, snapshot_id(buffer.data(), buffer.size()));
+    }
+    remember_flashcards_signature();
+    return written;
+}
+
+// Journal fields for a card: type, question, answer, option count, options...
+static void append_card_fields(JournalRecord& record, const Card& card) {
+    record.fields.push_back(card_type_name(card.type));
+    record.fields.push_back(card.question);
+    record.fields.push_back(card.answer);
+    record.fields.push_back(std::to_string(card.options.size()));
+    for (const auto& option : card.options) {
+        record.fields.push_back(option);
+    }
+}
+
+// Reads one card starting at fields[pos] and advances pos past it.
+static bool card_from_fields(const std::vector<std::string>& fields, size_t& pos, Card& card) {
+    if (fields.size() < pos + 4) return false;
+    card.type = card_type_from_name(fields[pos].data(), fields[pos].size());
+    card.question = fields[pos + 1];
+    card.answer = fields[pos + 2];
+    size_t num_options;
+    if (!indexFromField(fields[pos + 3], fields.size() + 1, num_options)) return false;
+    pos += 4;
+    if (fields.size() < pos + num_options) return false;
+    card.options.assign(fields.begin() + pos, fields.begin() + pos + num_options);
+    pos += num_options;
+    return true;
+}
+
+static void append_card_fields(JournalRecord& record, const CardView& card) {
+    record.fields.push_back(card.type_name());
+    record.fields.push_back(card.question().str());
+    record.fields.push_back(card.answer().str());
+    size_t count = card.option_count();
+    record.fields.push_back(std::to_string(count));
+    for (size_t k = 0; k < count; ++k) {
+        record.fields.push_back(card.option(k).str());
+    }
+}
+
+static bool apply_flashcard_journal_record(const JournalRecord& record) {
+    const std::vector<std::string>& fields = record.fields;
+    if (record.op == "ADD_DECK") {
+        // subject, title, timestamp, then each card's fields
+        if (fields.size() < 3) return false;
+        Deck deck;
+        deck.subject = fields[0];
+        deck.title = fields[1];
+        deck.timestamp = fields[2];
+        size_t pos = 3;
+        while (pos < fields.size()) {
+            Card card;
+            if (!card_from_fields(fields, pos, card)) return false;
+            deck.cards.push_back(card);
+        }
+        flashcard_decks.push_back(deck);
+        return true;
+    }
+    size_t deck_index;
+    if (fields.empty() || !indexFromField(fields[0], flashcard_decks.size(), deck_index)) return false;
+    if (record.op == "ADD_CARD") {
+        size_t pos = 1;
+        Card card;
+        if (!card_from_fields(fields, pos, card)) return false;
+        flashcard_decks[deck_index].cards.push_back(card);
+        flashcard_decks[deck_index].dirty = true;
+        return true;
+    }
+    if (record.op == "DELETE_DECK") {
+        flashcard_decks.erase(flashcard_decks.begin() + deck_index);
+        return true;
+    }
+    return false; // Unknown operation
+}
+
+void load_flashcards_from_file() {
+    flashcard_decks.clear();
+    bool corrupt = false;
+    MappedFile snapshot;
+    snapshot.open(FLASHCARDS_FILE);
+    uint64_t snapshotId = snapshot_id(snapshot.data(), snapshot.size()); // The journal is based on the text snapshot
+    // The binary store skips line parsing, but only while it mirrors this exact snapshot
+    if (!read_flashcards_binary_for(FLASHCARDS_BINARY_FILE, snapshotId, flashcard_decks)) {
+        flashcard_decks.clear();
+        corrupt = snapshot.is_open() && !read_flashcards_text(snapshot.data(), snapshot.size(), flashcard_decks);
+    }
+    snapshot.close();
+    if (corrupt) {
+        flashcard_decks.clear(); // Ensure clear on corruption
+    } else {
+        replay_journal(FLASHCARDS_JOURNAL_FILE, snapshotId, apply_flashcard_journal_record);
+        if (journal_needs_compaction(FLASHCARDS_JOURNAL_FILE)) {
+            save_flashcards_to_file();
+        }
+    }
+    load_card_memory_from_file();
+    rebuild_deck_subjects();
+    remember_flashcards_signature();
+}
+
+bool rebuild_flashcards_text_from_binary() {
+    uint64_t mirrored_id;
+    if (!read_flashcards_binary(FLASHCARDS_BINARY_FILE, flashcard_decks, mirrored_id)) {
+        return false;
+    }
+    // The journal was started against the text the store mirrors, which may be gone
+    replay_journal(FLASHCARDS_JOURNAL_FILE, mirrored_id, apply_flashcard_journal_record);
+    for (auto& deck : flashcard_decks) {
+        deck.dirty = true; // Their ranges point into that text, not the current flashcards.dat
+    }
+    flashcards_signatures[0] = FileSignature(); // Nothing to copy from
+    bool saved = save_flashcards_to_file();
+    load_card_memory_from_file();
+    rebuild_deck_subjects();
+    // The save removed the store; build it again from the new text so the two match
+    return saved && convert_flashcards_text_to_binary(FLASHCARDS_FILE, FLASHCARDS_BINARY_FILE);
+}
+
+void save_card_memory_to_file() {
+    std::string buffer;
+    buffer += std::to_string(flashcard_decks.size()) + '\n';
+    char line[128];
+    for (const auto& deck : flashcard_decks) {
+        buffer += deck.timestamp + '\n' + deck.title + '\n' + std::to_string(deck.cards.size()) + '\n';
+        for (const auto& card : deck.cards) {
+            const CardMemory& m = card.memory();
+            std::snprintf(line, sizeof(line), "%g %d %d %d %d\n", m.ease, m.interval_days, m.due_day, m.lapses, m.repetitions);
+            buffer += line;
+        }
+    }
+    write_file_atomically(FLASHCARD_MEMORY_FILE, buffer);
+}
+
+void load_card_memory_from_file() {
+    std::ifstream infile(FLASHCARD_MEMORY_FILE);
+    if (infile) {
+        std::map<std::pair<std::string, std::string>, size_t> deck_by_key; // (timestamp, title) -> deck index
+        for (size_t i = 0; i < flashcard_decks.size(); ++i) {
+            deck_by_key.insert(std::make_pair(std::make_pair(flashcard_decks[i].timestamp, flashcard_decks[i].title), i));
+        }
+
+        size_t num_decks = 0;
+        infile >> num_decks;
+        infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        for (size_t d = 0; d < num_decks && infile; ++d) {
+            std::string timestamp, title;
+            size_t num_cards = 0;
+            std::getline(infile, timestamp);
+            std::getline(infile, title);
+            infile >> num_cards;
+            auto found = deck_by_key.find(std::make_pair(timestamp, title));
+            Deck* deck = found == deck_by_key.end() ? nullptr : &flashcard_decks[found->second];
+            for (size_t c = 0; c < num_cards && infile; ++c) {
+                CardMemory m;
+                infile >> m.ease >> m.interval_days >> m.due_day >> m.lapses >> m.repetitions;
+                if (infile && deck && c < deck->cards.size()) {
+                    deck->cards.memory(c) = m; // Decks deleted since the last save are skipped
+                }
+            }
+            infile.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+    for (auto& deck : flashcard_decks) {
+        reset_due_index(deck);
+    }
+}
+
+static void append_flashcard_journal_record(const JournalRecord& record) {
+    if (!append_journal_record(FLASHCARDS_JOURNAL_FILE, record) || journal_needs_compaction(FLASHCARDS_JOURNAL_FILE)) {
+        save_flashcards_to_file();
+    }
+    remember_flashcards_signature(); // Our own append is not an external change
+}
+
+void journal_deck_added(const Deck& deck) {
+    JournalRecord record;
+    record.op = "ADD_DECK";
+    record.fields.push_back(deck.subject);
+    record.fields.push_back(deck.title);
+    record.fields.push_back(deck.timestamp);
+    for (const auto& card : deck.cards) {
+        append_card_fields(record, card);
+    }
+    append_flashcard_journal_record(record);
+}
+
+void journal_card_added(size_t deck_index, const Card& card) {
+    JournalRecord record;
+    record.op = "ADD_CARD";
+    record.fields.push_back(std::to_string(deck_index));
+    append_card_fields(record, card);
+    append_flashcard_journal_record(record);
+}
+
+void journal_deck_deleted(size_t deck_index) {
+    JournalRecord record;
+    record.op = "DELETE_DECK";
+    record.fields.push_back(std::to_string(deck_index));
+    append_flashcard_journal_record(record);
+}
+
+// Appends the .dat text of one notebook to `out`.
+static void serialize_notebook_text(const Notebook& notebook, std::string& out) {
+    out += notebook.subject + '\n';
+    out += std::to_string(notebook.notes.size()) + '\n';
+
+    for (const auto& note : notebook.notes) {
+        out.append(note.topic_title.data, note.topic_title.size) += '\n';
+        out.append(note.timestamp.data, note.timestamp.size) += '\n';
+        (out += NOTE_CONTENT_START_DELIMITER) += '\n';
+        out.append(note.content.data, note.content.size) += '\n'; // Assuming content does not contain NOTE_CONTENT_END_DELIMITER internally
+        (out += NOTE_CONTENT_END_DELIMITER) += '\n';
+    }
+}
+
+void save_notebooks_to_file() {
+    // Only notebooks changed since the last save are re-serialized; the rest are copied from the old snapshot.
+    std::string buffer;
+    std::vector<std::pair<size_t, size_t> > ranges;
+    {
+        MappedFile previous;
+        open_previous_snapshot(previous, NOTEBOOKS_FILE, notebooks_signatures[0]);
+        buffer.reserve(previous.size() + 16);
+        build_record_snapshot(notebooks, previous, serialize_notebook_text, buffer, ranges);
+    }
+    if (write_file_atomically(NOTEBOOKS_FILE, buffer)) {
+        apply_record_ranges(notebooks, ranges);
+        truncate_journal(NOTEBOOKS_JOURNAL_FILE, snapshot_id(buffer.data(), buffer.size()));
+    }
+    remember_notebooks_signature();
+}
+
+// Parses a notebooks snapshot into notebooks. Returns false on corruption.
+static bool read_notebooks_snapshot(const MappedFile& snapshot) {
+    LineReader reader(snapshot.data(), snapshot.size());
+    long long num_notebooks;
+    if (!reader.next_int(num_notebooks) || num_notebooks < 0) {
+        return false;
+    }
+    notebooks.reserve(static_cast<size_t>(std::min<long long>(num_notebooks, reader.remaining() / 2 + 1)));
+
+    const char* line;
+    size_t length;
+    for (long long i = 0; i < num_notebooks; ++i) {
+        notebooks.emplace_back(); // Filled in place
+        Notebook& current_notebook = notebooks.back();
+        const char* notebook_begin = reader.position();
+        long long num_notes;
+        if (!reader.next_string(current_notebook.subject) ||
+            !reader.next_int(num_notes) || num_notes < 0) {
+            return false;
+        }
+        current_notebook.notes.reserve(static_cast<size_t>(std::min<long long>(num_notes, reader.remaining() / 5 + 1)));
+
+        for (long long j = 0; j < num_notes; ++j) {
+            current_notebook.notes.emplace_back();
+            Note& current_note = current_notebook.notes.back();
+            // Text is copied into notebooks_arena; the mapping is closed after loading.
+            if (!reader.next_line(line, length)) return false;
+            current_note.topic_title = notebooks_arena.copy(line, length);
+            if (!reader.next_line(line, length)) return false;
+            current_note.timestamp = notebooks_arena.copy(line, length);
+            if (!reader.next_line(line, length) || NOTE_CONTENT_START_DELIMITER.compare(0, std::string::npos, line, length) != 0) {
+                 return false;
+            }
+
+            const char* content_begin = nullptr; // First content line
+            bool closed = false;
+            while (reader.next_line(line, length)) {
+                if (NOTE_CONTENT_END_DELIMITER.compare(0, std::string::npos, line, length) == 0) {
+                    closed = true;
+                    break;
+                }
+                if (!content_begin) content_begin = line;
+            }
+            if (!closed) { // File ended unexpectedly
+                 return false;
+            }
+            if (content_begin) {
+                // The content lines are contiguous in the file and up to the end marker
+                // (`line`) bound the joined text, so one arena block takes them all;
+                // copying line by line drops any '\r' like the rest of the loader.
+                size_t span = static_cast<size_t>(line - content_begin);
+                char* content = static_cast<char*>(notebooks_arena.allocate(span));
+                size_t used = 0;
+                LineReader content_lines(content_begin, span);
+                const char* content_line;
+                size_t content_length;
+                while (content_lines.next_line(content_line, content_length)) {
+                    if (used > 0) content[used++] = '\n';
+                    std::memcpy(content + used, content_line, content_length);
+                    used += content_length;
+                }
+                current_note.content = StringRef(content, used);
+            }
+        }
+        current_notebook.snapshot_offset = static_cast<size_t>(notebook_begin - snapshot.data());
+        current_notebook.snapshot_length = static_cast<size_t>(reader.position() - notebook_begin);
+        current_notebook.dirty = false;
+    }
+    return true;
+}
+
+static bool apply_notebook_journal_record(const JournalRecord& record) {
+    if (record.op == "ADD_NOTE") {
+        // subject, topic title, timestamp, content
+        if (record.fields.size() != 4) return false;
+        Note note;
+        note.topic_title = notebooks_arena.copy(record.fields[1]);
+        note.timestamp = notebooks_arena.copy(record.fields[2]);
+        note.content = notebooks_arena.copy(record.fields[3]);
+        Notebook* subject_notebook = nullptr;
+        size_t notebook_index = subject_registry.notebook_for(record.fields[0]);
+        if (notebook_index != NO_NOTEBOOK) {
+            subject_notebook = &notebooks[notebook_index];
+        } else {
+            notebooks.emplace_back();
+            subject_notebook = &notebooks.back();
+            subject_notebook->subject = record.fields[0];
+            subject_registry.set_notebook(notebooks.size() - 1, record.fields[0]);
+        }
+        subject_notebook->notes.push_back(note);
+        subject_notebook->dirty = true;
+        return true;
+    }
+    return false; // Unknown operation
+}
+
+void load_notebooks_from_file() {
+    clear_notebooks();
+    MappedFile snapshot;
+    bool corrupt = snapshot.open(NOTEBOOKS_FILE) && !read_notebooks_snapshot(snapshot);
+    uint64_t snapshotId = snapshot_id(snapshot.data(), snapshot.size());
+    snapshot.close();
+    if (corrupt) {
+        clear_notebooks(); // Ensure clear on corruption
+        rebuild_notebook_subjects();
+    } else {
+        rebuild_notebook_subjects(); // Journal replay finds notebooks through subject_registry
+        replay_journal(NOTEBOOKS_JOURNAL_FILE, snapshotId, apply_notebook_journal_record);
+        if (journal_needs_compaction(NOTEBOOKS_JOURNAL_FILE)) {
+            save_notebooks_to_file();
+        }
+    }
+    note_search_index.build(notebooks);
+    remember_notebooks_signature();
+}
+
+void journal_note_added(const std::string& subject, const Note& note) {
+    JournalRecord record;
+    record.op = "ADD_NOTE";
+    record.fields.push_back(subject);
+    record.fields.push_back(note.topic_title.str());
+    record.fields.push_back(note.timestamp.str());
+    record.fields.push_back(note.content.str());
+    if (!append_journal_record(NOTEBOOKS_JOURNAL_FILE, record) || journal_needs_compaction(NOTEBOOKS_JOURNAL_FILE)) {
+        save_notebooks_to_file();
+    }
+    remember_notebooks_signature();
+}
@@ -1,44 +1,83 @@
-#ifndef FILE_HANDLER_H
-#define FILE_HANDLER_H
-
-#include <string>
-#include <vector>
-#include <fstream>
-#include <iostream> // For std::cerr (though consider minimizing iostream in headers)
-#include <algorithm> // For std::replace in saveTasksToFile, if definition is here
-
-// Forward declarations for data structures used by file handlers
-// These structures will be fully defined in their respective feature headers (e.g., scheduler_planner.h, study_hub.h)
-struct ClassDetails;
-struct TaskDetails;
-struct Deck;
-// struct Card; // Card is part of Deck, so Deck's definition will include it.
-// struct Note; // Note is part of Notebook.
-struct Notebook;
-
-// Extern declarations for global data vectors that file handlers will operate on.
-// These will be defined in the .cpp file where they logically belong (e.g., scheduler_planner.cpp, study_hub.cpp or a central data.cpp)
-extern std::vector<ClassDetails> classSchedule;
-extern std::vector<TaskDetails> tasks;
-extern std::vector<Deck> flashcard_decks;
-extern std::vector<Notebook> notebooks;
-
-// Extern declarations for file constants
-extern const std::string FLASHCARDS_FILE;
-extern const std::string NOTEBOOKS_FILE;
-extern const std::string NOTE_CONTENT_START_DELIMITER;
-extern const std::string NOTE_CONTENT_END_DELIMITER;
-extern const std::string CLASS_SCHEDULE_FILE;
-extern const std::string TASKS_FILE;
-
-// Function Declarations
-void saveClassScheduleToFile();
-void loadClassScheduleFromFile();
-void saveTasksToFile();
-void loadTasksFromFile();
-void save_flashcards_to_file();
-void load_flashcards_from_file();
-void save_notebooks_to_file();
-void load_notebooks_from_file();
-
-#endif // FILE_HANDLER_H
+#ifndef FILE_HANDLER_H
+#define FILE_HANDLER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream> // For std::cerr (though consider minimizing iostream in headers)
+#include <algorithm> // For std::replace in saveTasksToFile, if definition is here
+
+// Forward declarations for data structures used by file handlers
+// These structures will be fully defined in their respective feature headers (e.g., scheduler_planner.h, study_hub.h)
+struct ClassDetails;
+struct TaskDetails;
+struct Deck;
+struct Card;
+struct Note;
+struct Notebook;
+
+// Extern declarations for global data vectors that file handlers will operate on.
+// These will be defined in the .cpp file where they logically belong (e.g., scheduler_planner.cpp, study_hub.cpp or a central data.cpp)
+extern std::vector<ClassDetails> classSchedule;
+extern std::vector<TaskDetails> tasks;
+extern std::vector<Deck> flashcard_decks;
+extern std::vector<Notebook> notebooks;
+
+// Extern declarations for file constants
+extern const std::string FLASHCARDS_FILE;
+extern const std::string NOTEBOOKS_FILE;
+extern const std::string NOTE_CONTENT_START_DELIMITER;
+extern const std::string NOTE_CONTENT_END_DELIMITER;
+extern const std::string CLASS_SCHEDULE_FILE;
+extern const std::string TASKS_FILE;
+extern const std::string FLASHCARDS_JOURNAL_FILE;
+extern const std::string FLASHCARDS_BINARY_FILE;
+extern const std::string NOTEBOOKS_JOURNAL_FILE;
+extern const std::string CLASS_SCHEDULE_JOURNAL_FILE;
+extern const std::string TASKS_JOURNAL_FILE;
+extern const std::string FLASHCARD_MEMORY_FILE;
+extern const std::string TERM_CALENDAR_FILE;
+
+// Function Declarations
+// Save functions write a full snapshot and empty the store's journal. The snapshot is
+// built in memory and swapped in atomically (atomic_file.h); on failure the old file
+// and the journal are both kept.
+// Load functions read the snapshot and then replay the journal on top of it.
+void saveClassScheduleToFile();
+void loadClassScheduleFromFile();
+// The term calendar (term_calendar.h) is a few lines; it is saved whole on every
+// change, without a journal, and loaded alongside the class schedule.
+void saveTermCalendarToFile();
+void loadTermCalendarFromFile();
+void saveTasksToFile();
+void loadTasksFromFile();
+bool save_flashcards_to_file(); // False if flashcards.dat couldn't be written
+void load_flashcards_from_file();
+// True if the snapshot or journal changed on disk since this process last loaded or wrote it.
+bool flashcards_changed_on_disk();
+bool notebooks_changed_on_disk();
+// Spaced-repetition card state lives in its own file so flashcards.dat keeps its format.
+// Decks are matched by timestamp and title, cards by position. Loaded by load_flashcards_from_file.
+void save_card_memory_to_file();
+void load_card_memory_from_file();
+bool read_flashcards_text(const char* data, size_t size, std::vector<Deck>& decks); // Returns false on corruption
+// `convert-flashcards --to-text`: loads the decks from flashcards.bin, replays the
+// journal on top as if they came from the flashcards.dat the store mirrors, then
+// saves a fresh flashcards.dat and empties the journal. False if the store can't be read.
+bool rebuild_flashcards_text_from_binary();
+void save_notebooks_to_file();
+void load_notebooks_from_file();
+
+// Journaled mutations: append one record per change instead of rewriting the snapshot.
+// Each call compacts the store into its snapshot once the journal grows past the threshold.
+void journalClassAdded(const ClassDetails& cls);
+void journalClassEdited(size_t classIndex, const ClassDetails& cls);
+void journalTaskAdded(const TaskDetails& task);
+void journalTaskCompleted(size_t taskIndex);
+void journalTaskDeleted(size_t taskIndex);
+void journal_deck_added(const Deck& deck);
+void journal_card_added(size_t deck_index, const Card& card);
+void journal_deck_deleted(size_t deck_index);
+void journal_note_added(const std::string& subject, const Note& note);
+
+#endif // FILE_HANDLER_H
@@ -0,0 +1,253 @@
+#include "flashcard_binary.h"
+#include "study_core.h"   // For Deck, Card definitions
+#include "file_handler.h" // For read_flashcards_text
+#include "atomic_file.h"  // The store is replaced whole, like the text snapshots
+#include "journal.h"      // For snapshot_id
+#include <cstring>
+#include <limits>
+
+static const char FLASHCARD_BINARY_MAGIC[8] = {'I', 'S', 'K', 'F', 'C', 'B', 'I', 'N'};
+
+// True if [offset, offset + count * elem_size) lies within a file of file_size bytes.
+static bool table_fits(uint64_t offset, uint64_t count, size_t elem_size, size_t file_size) {
+    if (offset > file_size) return false;
+    uint64_t available = file_size - offset;
+    return count <= available / elem_size;
+}
+
+FlashcardBinaryView::FlashcardBinaryView()
+    : header_(nullptr), decks_(nullptr), cards_(nullptr), options_(nullptr), pool_(nullptr) {}
+
+bool FlashcardBinaryView::open(const std::string& path) {
+    close();
+    if (!file_.open(path)) {
+        return false;
+    }
+    if (file_.size() < sizeof(FlashcardBinaryHeader)) {
+        close();
+        return false;
+    }
+    const FlashcardBinaryHeader* header = reinterpret_cast<const FlashcardBinaryHeader*>(file_.data());
+    if (std::memcmp(header->magic, FLASHCARD_BINARY_MAGIC, sizeof(FLASHCARD_BINARY_MAGIC)) != 0 ||
+        header->version != FLASHCARD_BINARY_VERSION ||
+        header->endianTag != FLASHCARD_BINARY_ENDIAN_TAG ||
+        !table_fits(header->deckTableOffset, header->deckCount, sizeof(BinaryDeckRecord), file_.size()) ||
+        !table_fits(header->cardTableOffset, header->cardCount, sizeof(BinaryCardRecord), file_.size()) ||
+        !table_fits(header->optionTableOffset, header->optionCount, sizeof(BinaryString), file_.size()) ||
+        !table_fits(header->stringPoolOffset, header->stringPoolSize, 1, file_.size())) {
+        close();
+        return false;
+    }
+    header_ = header;
+    decks_ = reinterpret_cast<const BinaryDeckRecord*>(file_.data() + header->deckTableOffset);
+    cards_ = reinterpret_cast<const BinaryCardRecord*>(file_.data() + header->cardTableOffset);
+    options_ = reinterpret_cast<const BinaryString*>(file_.data() + header->optionTableOffset);
+    pool_ = file_.data() + header->stringPoolOffset;
+    return true;
+}
+
+void FlashcardBinaryView::close() {
+    file_.close();
+    header_ = nullptr;
+    decks_ = nullptr;
+    cards_ = nullptr;
+    options_ = nullptr;
+    pool_ = nullptr;
+}
+
+uint64_t FlashcardBinaryView::text_snapshot_id() const {
+    return header_ ? header_->textSnapshotId : 0;
+}
+
+size_t FlashcardBinaryView::deck_count() const {
+    return header_ ? static_cast<size_t>(header_->deckCount) : 0;
+}
+
+const BinaryDeckRecord& FlashcardBinaryView::deck(size_t index) const {
+    static const BinaryDeckRecord empty_deck = BinaryDeckRecord();
+    if (index >= deck_count()) {
+        return empty_deck; // Out of range; an empty deck rather than a read past the table
+    }
+    return decks_[index];
+}
+
+const BinaryCardRecord& FlashcardBinaryView::card(const BinaryDeckRecord& deck, size_t index) const {
+    static const BinaryCardRecord empty_card = BinaryCardRecord();
+    uint64_t position = deck.firstCard + index;
+    if (index >= deck.cardCount || position >= header_->cardCount) {
+        return empty_card; // Corrupt deck record; treat the card as blank rather than reading out of bounds
+    }
+    return cards_[position];
+}
+
+StringRef FlashcardBinaryView::option(const BinaryCardRecord& card, size_t index) const {
+    uint64_t position = card.firstOption + index;
+    if (index >= card.optionCount || position >= header_->optionCount) {
+        StringRef empty = {"", 0};
+        return empty;
+    }
+    return str(options_[position]);
+}
+
+StringRef FlashcardBinaryView::str(const BinaryString& s) const {
+    if (!pool_ || s.offset > header_->stringPoolSize || s.length > header_->stringPoolSize - s.offset) {
+        StringRef empty = {"", 0};
+        return empty;
+    }
+    StringRef ref = {pool_ + s.offset, s.length};
+    return ref;
+}
+
+// --- Writer ---
+
+// True if `count` fits the 32-bit length and count fields.
+static bool fits_u32(size_t count) {
+    return count <= std::numeric_limits<uint32_t>::max();
+}
+
+// Clears `fits` instead of truncating a string too long for BinaryString::length.
+static BinaryString add_to_pool(std::string& pool, const char* data, size_t size, bool& fits) {
+    BinaryString s;
+    s.offset = pool.size();
+    s.length = 0;
+    s.reserved = 0;
+    if (!fits_u32(size)) {
+        fits = false;
+        return s;
+    }
+    s.length = static_cast<uint32_t>(size);
+    pool.append(data, size);
+    return s;
+}
+
+static BinaryString add_to_pool(std::string& pool, const std::string& value, bool& fits) {
+    return add_to_pool(pool, value.data(), value.size(), fits);
+}
+
+static BinaryString add_to_pool(std::string& pool, const StringRef& value, bool& fits) {
+    return add_to_pool(pool, value.data, value.size, fits);
+}
+
+bool write_flashcards_binary(const std::string& path, const std::vector<Deck>& decks, uint64_t text_snapshot_id) {
+    std::vector<BinaryDeckRecord> deck_table;
+    std::vector<BinaryCardRecord> card_table;
+    std::vector<BinaryString> option_table;
+    std::string pool;
+    bool fits = true;
+    deck_table.reserve(decks.size());
+
+    for (const auto& deck : decks) {
+        if (!fits_u32(deck.cards.size())) return false;
+        BinaryDeckRecord deck_record;
+        deck_record.subject = add_to_pool(pool, deck.subject, fits);
+        deck_record.title = add_to_pool(pool, deck.title, fits);
+        deck_record.timestamp = add_to_pool(pool, deck.timestamp, fits);
+        deck_record.firstCard = card_table.size();
+        deck_record.cardCount = static_cast<uint32_t>(deck.cards.size());
+        deck_record.reserved = 0;
+        deck_record.textOffset = deck.snapshot_offset;
+        deck_record.textLength = deck.snapshot_length;
+        deck_table.push_back(deck_record);
+
+        for (const auto& card : deck.cards) {
+            if (!fits_u32(card.option_count())) return false;
+            BinaryCardRecord card_record;
+            card_record.type = add_to_pool(pool, card.type_name(), std::strlen(card.type_name()), fits);
+            card_record.question = add_to_pool(pool, card.question(), fits);
+            card_record.answer = add_to_pool(pool, card.answer(), fits);
+            card_record.firstOption = option_table.size();
+            card_record.optionCount = static_cast<uint32_t>(card.option_count());
+            card_record.reserved = 0;
+            card_table.push_back(card_record);
+            for (size_t k = 0; k < card_record.optionCount; ++k) {
+                option_table.push_back(add_to_pool(pool, card.option(k), fits));
+            }
+        }
+        if (!fits) return false; // A string over 4 GiB; writing it truncated would corrupt the store
+    }
+
+    FlashcardBinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, FLASHCARD_BINARY_MAGIC, sizeof(header.magic));
+    header.version = FLASHCARD_BINARY_VERSION;
+    header.endianTag = FLASHCARD_BINARY_ENDIAN_TAG;
+    header.textSnapshotId = text_snapshot_id;
+    header.deckCount = deck_table.size();
+    header.cardCount = card_table.size();
+    header.optionCount = option_table.size();
+    header.deckTableOffset = sizeof(FlashcardBinaryHeader);
+    header.cardTableOffset = header.deckTableOffset + deck_table.size() * sizeof(BinaryDeckRecord);
+    header.optionTableOffset = header.cardTableOffset + card_table.size() * sizeof(BinaryCardRecord);
+    header.stringPoolOffset = header.optionTableOffset + option_table.size() * sizeof(BinaryString);
+    header.stringPoolSize = pool.size();
+
+    std::string buffer;
+    buffer.reserve(header.stringPoolOffset + pool.size());
+    buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    if (!deck_table.empty()) buffer.append(reinterpret_cast<const char*>(&deck_table[0]), deck_table.size() * sizeof(BinaryDeckRecord));
+    if (!card_table.empty()) buffer.append(reinterpret_cast<const char*>(&card_table[0]), card_table.size() * sizeof(BinaryCardRecord));
+    if (!option_table.empty()) buffer.append(reinterpret_cast<const char*>(&option_table[0]), option_table.size() * sizeof(BinaryString));
+    buffer += pool;
+    return write_file_atomically(path, buffer);
+}
+
+// Copies every deck of an open store into `decks`; they load clean, pointing at the mirrored text.
+static void materialize_decks(const FlashcardBinaryView& view, std::vector<Deck>& decks) {
+    decks.clear();
+    decks.resize(view.deck_count());
+    for (size_t i = 0; i < view.deck_count(); ++i) {
+        const BinaryDeckRecord& deck_record = view.deck(i);
+        Deck& deck = decks[i];
+        deck.subject = view.str(deck_record.subject).str();
+        deck.title = view.str(deck_record.title).str();
+        deck.timestamp = view.str(deck_record.timestamp).str();
+        deck.snapshot_offset = static_cast<size_t>(deck_record.textOffset);
+        deck.snapshot_length = static_cast<size_t>(deck_record.textLength);
+        deck.dirty = false; // build_record_snapshot checks the range against the file before copying it
+        deck.cards.reserve(deck_record.cardCount);
+        for (size_t j = 0; j < deck_record.cardCount; ++j) {
+            const BinaryCardRecord& card_record = view.card(deck_record, j);
+            StringRef type = view.str(card_record.type);
+            StringRef question = view.str(card_record.question);
+            StringRef answer = view.str(card_record.answer);
+            deck.cards.push_back(card_type_from_name(type.data, type.size), question.data, question.size, answer.data, answer.size);
+            for (size_t k = 0; k < card_record.optionCount; ++k) {
+                StringRef option = view.option(card_record, k);
+                deck.cards.push_option(option.data, option.size);
+            }
+        }
+    }
+}
+
+bool read_flashcards_binary(const std::string& path, std::vector<Deck>& decks, uint64_t& text_snapshot_id) {
+    FlashcardBinaryView view;
+    if (!view.open(path)) {
+        return false;
+    }
+    text_snapshot_id = view.text_snapshot_id();
+    materialize_decks(view, decks);
+    return true;
+}
+
+bool read_flashcards_binary_for(const std::string& path, uint64_t text_snapshot_id, std::vector<Deck>& decks) {
+    FlashcardBinaryView view;
+    if (!view.open(path) || view.text_snapshot_id() != text_snapshot_id) {
+        return false;
+    }
+    materialize_decks(view, decks);
+    return true;
+}
+
+// --- Converters ---
+
+bool convert_flashcards_text_to_binary(const std::string& text_path, const std::string& binary_path) {
+    MappedFile text;
+    if (!text.open(text_path)) {
+        return false;
+    }
+    std::vector<Deck> decks;
+    if (!read_flashcards_text(text.data(), text.size(), decks)) {
+        return false;
+    }
+    return write_flashcards_binary(binary_path, decks, snapshot_id(text.data(), text.size()));
+}
@@ -0,0 +1,112 @@
+#ifndef FLASHCARD_BINARY_H
+#define FLASHCARD_BINARY_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "mapped_file.h"
+#include "card_store.h" // For StringRef
+
+struct Deck;
+
+// --- Binary flashcard store (flashcards.bin) ---
+// Layout, all integers in host byte order:
+//   FlashcardBinaryHeader
+//   deck table   : deckCount   x BinaryDeckRecord
+//   card table   : cardCount   x BinaryCardRecord   (cards of deck i are contiguous)
+//   option table : optionCount x BinaryString       (options of card j are contiguous)
+//   string pool  : raw UTF-8 bytes referenced by every BinaryString
+// Readers map the file and hand out pointers into it, so opening the store
+// costs O(1) regardless of how many cards it holds.
+//
+// The store mirrors one flashcards.dat: the header holds that file's
+// snapshot_id (journal.h) and each deck its byte range in it. It is built only
+// by `convert-flashcards`. load_flashcards_from_file reads it instead of
+// parsing the text while the ids match, and its decks load clean, so a save
+// still copies their text. A save that replaces flashcards.dat deletes the
+// store, and a store whose id doesn't match is never read.
+
+const uint32_t FLASHCARD_BINARY_VERSION = 2;
+const uint32_t FLASHCARD_BINARY_ENDIAN_TAG = 0x01020304;
+
+struct BinaryString {
+    uint64_t offset; // Relative to the start of the string pool
+    uint32_t length;
+    uint32_t reserved;
+};
+
+struct FlashcardBinaryHeader {
+    char magic[8];       // "ISKFCBIN"
+    uint32_t version;
+    uint32_t endianTag;  // FLASHCARD_BINARY_ENDIAN_TAG as written by the producing host
+    uint64_t textSnapshotId; // snapshot_id of the flashcards.dat this store mirrors
+    uint64_t deckCount;
+    uint64_t cardCount;
+    uint64_t optionCount;
+    uint64_t deckTableOffset;
+    uint64_t cardTableOffset;
+    uint64_t optionTableOffset;
+    uint64_t stringPoolOffset;
+    uint64_t stringPoolSize;
+};
+
+struct BinaryDeckRecord {
+    BinaryString subject;
+    BinaryString title;
+    BinaryString timestamp;
+    uint64_t firstCard;
+    uint32_t cardCount;
+    uint32_t reserved;
+    uint64_t textOffset; // The deck's bytes in the mirrored flashcards.dat
+    uint64_t textLength;
+};
+
+struct BinaryCardRecord {
+    BinaryString type;
+    BinaryString question;
+    BinaryString answer;
+    uint64_t firstOption;
+    uint32_t optionCount;
+    uint32_t reserved;
+};
+
+// Zero-copy reader over a mapped flashcards.bin.
+class FlashcardBinaryView {
+public:
+    FlashcardBinaryView();
+
+    bool open(const std::string& path); // Validates header and table bounds
+    void close();
+
+    uint64_t text_snapshot_id() const;
+    size_t deck_count() const;
+    const BinaryDeckRecord& deck(size_t index) const; // An empty record if index >= deck_count()
+    const BinaryCardRecord& card(const BinaryDeckRecord& deck, size_t index) const;
+    StringRef option(const BinaryCardRecord& card, size_t index) const;
+    StringRef str(const BinaryString& s) const; // Empty ref if the string lies outside the pool
+
+private:
+    MappedFile file_;
+    const FlashcardBinaryHeader* header_;
+    const BinaryDeckRecord* decks_;
+    const BinaryCardRecord* cards_;
+    const BinaryString* options_;
+    const char* pool_;
+};
+
+// Serializes decks as read from the flashcards.dat whose snapshot_id is
+// `text_snapshot_id` (their snapshot ranges point into it) and replaces `path`
+// atomically. Returns false on I/O failure, leaving any previous file in place,
+// or if a string or count is too large for the 32-bit fields, writing nothing.
+bool write_flashcards_binary(const std::string& path, const std::vector<Deck>& decks, uint64_t text_snapshot_id);
+// Materializes every deck of a binary store into `decks`, clean and with their
+// text ranges. `text_snapshot_id` receives the id of the text it mirrors.
+bool read_flashcards_binary(const std::string& path, std::vector<Deck>& decks, uint64_t& text_snapshot_id);
+// Same, but only if the store mirrors the snapshot `text_snapshot_id`; false otherwise.
+bool read_flashcards_binary_for(const std::string& path, uint64_t text_snapshot_id, std::vector<Deck>& decks);
+
+// Builds the binary store from a text snapshot. The reverse, which must also
+// account for the journal, is rebuild_flashcards_text_from_binary (file_handler.h).
+bool convert_flashcards_text_to_binary(const std::string& text_path, const std::string& binary_path);
+
+#endif // FLASHCARD_BINARY_H
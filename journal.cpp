@@ -0,0 +1,190 @@
+#include "journal.h"
+#include "atomic_file.h" // For sync_parent_directory
+#include <fstream>
+#include <map>
+#include <set>
+#include <mutex>   // Stores may be loaded concurrently at startup
+#include <cstdio>  // For std::remove
+#include <cstdlib> // For std::strtoul
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #define ISKAALAMAN_HAVE_POSIX_IO 1
+#endif
+
+// Records currently in each journal, tracked in memory so the compaction check never touches the disk.
+static std::map<std::string, size_t> journal_record_counts;
+// Journals whose last replay stopped before the end of the file. Anything appended after a
+// torn record would be unreachable, so these must be compacted before the next append.
+static std::set<std::string> journals_with_torn_tail;
+// Snapshot each journal applies to, written as the BASE record when the journal is started.
+static std::map<std::string, uint64_t> journal_bases;
+// Journals that already exist on disk, so appends don't write a second BASE record.
+static std::set<std::string> journals_started;
+static std::mutex journal_state_mutex; // Guards the containers above
+
+static const char JOURNAL_BASE_OP[] = "BASE";
+
+uint64_t snapshot_id(const char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static void encode_journal_record(const JournalRecord& record, std::string& encoded) {
+    encoded += "@" + record.op + " " + std::to_string(record.fields.size()) + "\n";
+    for (const auto& field : record.fields) {
+        encoded += std::to_string(field.size());
+        encoded += '\n';
+        encoded += field;
+        encoded += '\n';
+    }
+}
+
+bool append_journal_record(const std::string& path, const JournalRecord& record) {
+    std::string encoded;
+    {
+        std::lock_guard<std::mutex> lock(journal_state_mutex);
+        std::map<std::string, uint64_t>::const_iterator base = journal_bases.find(path);
+        if (!journals_started.count(path) && base != journal_bases.end()) {
+            JournalRecord base_record;
+            base_record.op = JOURNAL_BASE_OP;
+            base_record.fields.push_back(std::to_string(base->second));
+            encode_journal_record(base_record, encoded);
+        }
+    }
+    encode_journal_record(record, encoded);
+
+#ifdef ISKAALAMAN_HAVE_POSIX_IO
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    const bool created = ::lseek(fd, 0, SEEK_END) == 0; // New or emptied journal
+    const char* data = encoded.data();
+    size_t remaining = encoded.size();
+    while (remaining > 0) { // Loop for short writes and EINTR, as write_file_atomically does
+        ssize_t written = ::write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    bool ok = remaining == 0 && ::fsync(fd) == 0; // The record is durable once this returns true
+    ok = ::close(fd) == 0 && ok;
+    if (!ok) {
+        return false;
+    }
+    if (created) {
+        sync_parent_directory(path);
+    }
+#else
+    std::ofstream outfile(path.c_str(), std::ios::binary | std::ios::app);
+    if (!outfile) {
+        return false;
+    }
+    outfile.write(encoded.data(), encoded.size());
+    outfile.flush();
+    if (outfile.fail()) {
+        return false;
+    }
+#endif
+    std::lock_guard<std::mutex> lock(journal_state_mutex);
+    ++journal_record_counts[path];
+    journals_started.insert(path);
+    return true;
+}
+
+// Reads "<number>\n"; returns false on a malformed or truncated line.
+static bool read_count_line(std::istream& in, size_t& value) {
+    std::string line;
+    if (!std::getline(in, line) || line.empty()) return false;
+    char* end = nullptr;
+    value = static_cast<size_t>(std::strtoul(line.c_str(), &end, 10));
+    return *end == '\0';
+}
+
+size_t replay_journal(const std::string& path, uint64_t snapshot,
+                      const std::function<bool(const JournalRecord&)>& apply) {
+    std::ifstream infile(path.c_str(), std::ios::binary);
+    if (!infile) {
+        std::lock_guard<std::mutex> lock(journal_state_mutex);
+        journal_record_counts[path] = 0;
+        journals_with_torn_tail.erase(path);
+        journals_started.erase(path);
+        journal_bases[path] = snapshot;
+        return 0;
+    }
+
+    size_t applied = 0;
+    bool torn = false;
+    bool first = true;
+    std::string header;
+    while (std::getline(infile, header)) {
+        torn = true; // Cleared once the record has been fully read and applied
+        size_t space = header.find(' ');
+        if (header.empty() || header[0] != '@' || space == std::string::npos) break;
+
+        JournalRecord record;
+        record.op = header.substr(1, space - 1);
+        char* end = nullptr;
+        size_t num_fields = static_cast<size_t>(std::strtoul(header.c_str() + space + 1, &end, 10));
+        if (*end != '\0') break;
+
+        bool complete = true;
+        for (size_t i = 0; i < num_fields && complete; ++i) {
+            size_t length = 0;
+            if (!read_count_line(infile, length)) { complete = false; break; }
+            std::string field(length, '\0');
+            if (length > 0 && !infile.read(&field[0], length)) { complete = false; break; }
+            if (infile.get() != '\n') { complete = false; break; }
+            record.fields.push_back(field);
+        }
+        if (!complete) break; // Torn tail from an interrupted append
+
+        if (record.op == JOURNAL_BASE_OP) {
+            // Only meaningful as the first record; a stale journal counts as torn so it gets compacted away
+            if (first && (record.fields.size() != 1 || record.fields[0] != std::to_string(snapshot))) break;
+            first = false;
+            torn = false;
+            continue;
+        }
+        first = false;
+        if (!apply(record)) break;
+        ++applied;
+        torn = false;
+    }
+    std::lock_guard<std::mutex> lock(journal_state_mutex);
+    journal_record_counts[path] = applied;
+    journals_started.insert(path);
+    journal_bases[path] = snapshot;
+    if (torn) {
+        journals_with_torn_tail.insert(path);
+    } else {
+        journals_with_torn_tail.erase(path);
+    }
+    return applied;
+}
+
+void truncate_journal(const std::string& path, uint64_t snapshot) {
+    std::remove(path.c_str());
+    std::lock_guard<std::mutex> lock(journal_state_mutex);
+    journal_record_counts[path] = 0;
+    journals_with_torn_tail.erase(path);
+    journals_started.erase(path);
+    journal_bases[path] = snapshot;
+}
+
+bool journal_needs_compaction(const std::string& path) {
+    std::lock_guard<std::mutex> lock(journal_state_mutex);
+    if (journals_with_torn_tail.count(path)) return true;
+    std::map<std::string, size_t>::const_iterator it = journal_record_counts.find(path);
+    return it != journal_record_counts.end() && it->second >= JOURNAL_COMPACTION_THRESHOLD;
+}
@@ -0,0 +1,51 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+// --- Append-only operation journal ---
+// Each store keeps a journal file next to its snapshot .dat file. Mutations
+// append one record instead of rewriting the snapshot; loading replays the
+// journal on top of the snapshot, and saving a snapshot empties the journal.
+//
+// Record encoding (fields are length-prefixed, so they may contain newlines):
+//   @<op> <field count>\n
+//   <byte length>\n<bytes>\n      (repeated for each field)
+// A torn record at the end of the file (e.g. after a crash) is ignored.
+//
+// A new journal starts with a "@BASE" record holding the id of the snapshot it
+// was started against (snapshot_id below). Saving renames the new snapshot in
+// and only then empties the journal, so a crash in between leaves a journal
+// whose records are already in the snapshot; its BASE no longer matches and
+// the replay skips it. Journals without a BASE record replay unconditionally.
+
+struct JournalRecord {
+    std::string op;
+    std::vector<std::string> fields;
+};
+
+// Once a journal holds this many records the owning store is compacted into its snapshot.
+const size_t JOURNAL_COMPACTION_THRESHOLD = 256;
+
+// Identifies a snapshot by its bytes (64-bit FNV-1a); a missing file is an empty one.
+uint64_t snapshot_id(const char* data, size_t size);
+
+// Appends one record and fsyncs it, so a true return means the edit survives a crash
+// (and a freshly created journal's directory entry is synced too). Without POSIX I/O
+// the record is only flushed to the OS. One fsync per call: O(record size) I/O.
+bool append_journal_record(const std::string& path, const JournalRecord& record);
+// Calls `apply` for each complete record in order; stops early if `apply` returns false.
+// `snapshot` is the id of the snapshot just loaded; a journal based on another
+// snapshot is not replayed and is flagged for compaction.
+// Returns the number of records applied.
+size_t replay_journal(const std::string& path, uint64_t snapshot,
+                      const std::function<bool(const JournalRecord&)>& apply);
+// Empties the journal once `snapshot` (the id of the snapshot just written) holds all of it.
+void truncate_journal(const std::string& path, uint64_t snapshot);
+bool journal_needs_compaction(const std::string& path); // Threshold reached, or the last replay hit a torn record
+
+#endif // JOURNAL_H
@@ -0,0 +1,62 @@
+#include "line_reader.h"
+#include <cstring> // For std::memchr
+#include <limits>
+
+bool LineReader::next_line(const char*& line, size_t& length) {
+    if (cursor_ >= end_) return false;
+    const char* newline = static_cast<const char*>(std::memchr(cursor_, '\n', static_cast<size_t>(end_ - cursor_)));
+    const char* line_end = newline ? newline : end_;
+    line = cursor_;
+    length = static_cast<size_t>(line_end - cursor_);
+    if (length > 0 && line[length - 1] == '\r') --length;
+    cursor_ = newline ? newline + 1 : end_;
+    return true;
+}
+
+bool LineReader::next_string(std::string& out) {
+    const char* line;
+    size_t length;
+    if (!next_line(line, length)) return false;
+    out.assign(line, length);
+    return true;
+}
+
+bool LineReader::next_int(long long& value) {
+    const char* line;
+    size_t length;
+    while (next_line(line, length)) {
+        size_t i = 0;
+        while (i < length && (line[i] == ' ' || line[i] == '\t')) ++i;
+        if (i == length) continue; // Blank line; operator>> would skip it too
+        return parse_leading_int(line, length, value);
+    }
+    return false;
+}
+
+bool parse_leading_int(const char* text, size_t length, long long& value) {
+    size_t i = 0;
+    while (i < length && (text[i] == ' ' || text[i] == '\t')) ++i;
+    bool negative = false;
+    if (i < length && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        ++i;
+    }
+    if (i == length || text[i] < '0' || text[i] > '9') return false;
+
+    // The negative range reaches one further: -9223372036854775808 is a valid long long.
+    const unsigned long long limit = static_cast<unsigned long long>(std::numeric_limits<long long>::max()) + (negative ? 1 : 0);
+    unsigned long long magnitude = 0;
+    for (; i < length && text[i] >= '0' && text[i] <= '9'; ++i) {
+        unsigned digit = static_cast<unsigned>(text[i] - '0');
+        if (magnitude > (limit - digit) / 10) return false;
+        magnitude = magnitude * 10 + digit;
+    }
+    if (!negative) {
+        value = static_cast<long long>(magnitude);
+    } else if (magnitude == limit) {
+        value = std::numeric_limits<long long>::min(); // Its magnitude has no positive long long
+    } else {
+        value = -static_cast<long long>(magnitude);
+    }
+    return true;
+}
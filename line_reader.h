@@ -0,0 +1,38 @@
+#ifndef LINE_READER_H
+#define LINE_READER_H
+
+#include <string>
+#include <cstddef>
+
+// --- Line-oriented reader over an in-memory file ---
+// Used by the .dat loaders on top of MappedFile: lines are found with memchr
+// (vectorized in every mainstream libc) and handed out as pointers into the
+// buffer, and integers are parsed straight from those bytes, so reading a
+// file costs no per-line allocation and no iostream machinery. A trailing
+// '\r' is dropped from every line, so files saved on Windows load the same.
+class LineReader {
+public:
+    LineReader(const char* data, size_t size) : cursor_(data), end_(data + size) {}
+
+    bool at_end() const { return cursor_ >= end_; }
+    size_t remaining() const { return at_end() ? 0 : static_cast<size_t>(end_ - cursor_); }
+    const char* position() const { return cursor_; } // Start of the next line
+
+    // Next line without its terminator. False once the data is exhausted.
+    bool next_line(const char*& line, size_t& length);
+    // Next line copied into `out`, reusing its capacity.
+    bool next_string(std::string& out);
+    // Next line that is not blank, parsed as an integer; anything after the number
+    // is ignored (matches `in >> value` followed by ignoring the rest of the line).
+    bool next_int(long long& value);
+
+private:
+    const char* cursor_;
+    const char* end_;
+};
+
+// Parses an optionally signed decimal integer at the start of text[0, length),
+// after optional spaces or tabs. Returns false if there is no digit or it overflows.
+bool parse_leading_int(const char* text, size_t length, long long& value);
+
+#endif // LINE_READER_H
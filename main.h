@@ -1,7 +1,7 @@
-#ifndef MAIN_H
-#define MAIN_H
-
-// Function declaration for the main menu display
-void displayMainMenu();
-
-#endif // MAIN_H
+#ifndef MAIN_H
+#define MAIN_H
+
+// Function declaration for the main menu display
+void displayMainMenu();
+
+#endif // MAIN_H
@@ -0,0 +1,72 @@
+#include "mapped_file.h"
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #define ISKAALAMAN_HAVE_MMAP 1
+#endif
+
+MappedFile::MappedFile() : data_(nullptr), size_(0), open_(false), mapped_(false) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef ISKAALAMAN_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ > 0) {
+        void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            size_ = 0;
+            return false;
+        }
+        data_ = static_cast<const char*>(addr);
+        mapped_ = true;
+    }
+    ::close(fd); // The mapping stays valid after the descriptor is closed
+#else
+    std::ifstream infile(path.c_str(), std::ios::binary | std::ios::ate);
+    if (!infile) {
+        return false;
+    }
+    std::streamsize length = infile.tellg();
+    infile.seekg(0, std::ios::beg);
+    buffer_.resize(static_cast<size_t>(length));
+    if (length > 0 && !infile.read(&buffer_[0], length)) {
+        buffer_.clear();
+        return false;
+    }
+    data_ = buffer_.empty() ? nullptr : &buffer_[0];
+    size_ = buffer_.size();
+#endif
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef ISKAALAMAN_HAVE_MMAP
+    if (mapped_ && data_) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    buffer_.clear();
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    mapped_ = false;
+}
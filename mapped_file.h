@@ -0,0 +1,34 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Read-only view of a whole file. On POSIX systems the file is mmap'ed so
+// opening it costs no copying; elsewhere it falls back to reading the file
+// into an owned buffer. The data stays valid until close() or destruction.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    bool open(const std::string& path); // Returns false if the file can't be opened or mapped
+    void close();
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool is_open() const { return open_; }
+
+private:
+    MappedFile(const MappedFile&);            // Non-copyable: owns the mapping
+    MappedFile& operator=(const MappedFile&);
+
+    const char* data_;
+    size_t size_;
+    bool open_;
+    bool mapped_;               // True when data_ points into an mmap'ed region
+    std::vector<char> buffer_;  // Fallback storage when mmap is unavailable
+};
+
+#endif // MAPPED_FILE_H
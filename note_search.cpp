@@ -0,0 +1,258 @@
+#include "note_search.h"
+#include <algorithm> // For std::sort, std::lower_bound, std::set_intersection, std::set_union, std::set_difference
+#include <iterator>  // For std::back_inserter
+#include <cmath>     // For std::log
+
+NoteSearchIndex note_search_index;
+
+// BM25 tuning constants (the usual defaults).
+static const double BM25_K1 = 1.2;
+static const double BM25_B = 0.75;
+
+static bool is_term_char(unsigned char c) {
+    // Bytes >= 0x80 are kept so UTF-8 words stay whole.
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+// Splits text into lowercase terms and appends them to `terms`.
+static void tokenize(const char* text, size_t length, std::vector<std::string>& terms) {
+    size_t i = 0;
+    while (i < length) {
+        while (i < length && !is_term_char(static_cast<unsigned char>(text[i]))) ++i;
+        size_t start = i;
+        while (i < length && is_term_char(static_cast<unsigned char>(text[i]))) ++i;
+        if (i > start) {
+            std::string term(text + start, i - start);
+            for (auto& c : term) {
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+            }
+            terms.push_back(term);
+        }
+    }
+}
+
+void NoteSearchIndex::clear() {
+    postings.clear();
+    documents.clear();
+    document_lengths.clear();
+    total_length = 0;
+}
+
+void NoteSearchIndex::build(const std::vector<Notebook>& all_notebooks) {
+    clear();
+    for (size_t nb = 0; nb < all_notebooks.size(); ++nb) {
+        for (size_t n = 0; n < all_notebooks[nb].notes.size(); ++n) {
+            add_note(nb, n, all_notebooks[nb].notes[n]);
+        }
+    }
+}
+
+void NoteSearchIndex::add_note(size_t notebook_index, size_t note_index, const Note& note) {
+    uint32_t doc = static_cast<uint32_t>(documents.size());
+    DocumentRef ref = {notebook_index, note_index};
+    documents.push_back(ref);
+
+    std::vector<std::string> terms;
+    tokenize(note.topic_title.data, note.topic_title.size, terms);
+    // Skip one position between title and content so a phrase cannot span the two.
+    uint32_t content_offset = static_cast<uint32_t>(terms.size()) + 1;
+    size_t title_terms = terms.size();
+    tokenize(note.content.data, note.content.size, terms);
+
+    for (size_t i = 0; i < terms.size(); ++i) {
+        uint32_t position = static_cast<uint32_t>(i < title_terms ? i : i - title_terms + content_offset);
+        std::vector<Posting>& list = postings[terms[i]];
+        if (list.empty() || list.back().doc != doc) {
+            list.push_back(Posting());
+            list.back().doc = doc;
+        }
+        list.back().positions.push_back(position);
+    }
+    document_lengths.push_back(static_cast<uint32_t>(terms.size()));
+    total_length += terms.size();
+}
+
+const std::vector<NoteSearchIndex::Posting>* NoteSearchIndex::find_postings(const std::string& term) const {
+    auto it = postings.find(term);
+    return it == postings.end() ? nullptr : &it->second;
+}
+
+// Doc ids (ascending) matching one clause. Phrases are checked position by position.
+std::vector<uint32_t> NoteSearchIndex::match_clause(const Clause& clause) const {
+    std::vector<uint32_t> result;
+    std::vector<const std::vector<Posting>*> lists;
+    for (const auto& term : clause) {
+        const std::vector<Posting>* list = find_postings(term);
+        if (!list) return result; // A missing term means nothing can match
+        lists.push_back(list);
+    }
+    if (lists.empty()) return result;
+
+    if (lists.size() == 1) {
+        result.reserve(lists[0]->size());
+        for (const auto& posting : *lists[0]) result.push_back(posting.doc);
+        return result;
+    }
+
+    // Walk the first term's list and look the doc up in the others.
+    std::vector<const Posting*> current(lists.size());
+    for (const auto& first : *lists[0]) {
+        current[0] = &first;
+        bool in_all = true;
+        for (size_t t = 1; t < lists.size() && in_all; ++t) {
+            auto it = std::lower_bound(lists[t]->begin(), lists[t]->end(), first.doc,
+                                       [](const Posting& p, uint32_t doc) { return p.doc < doc; });
+            if (it == lists[t]->end() || it->doc != first.doc) in_all = false;
+            else current[t] = &*it;
+        }
+        if (!in_all) continue;
+
+        for (uint32_t start : first.positions) {
+            bool phrase = true;
+            for (size_t t = 1; t < current.size() && phrase; ++t) {
+                phrase = std::binary_search(current[t]->positions.begin(), current[t]->positions.end(),
+                                            static_cast<uint32_t>(start + t));
+            }
+            if (phrase) {
+                result.push_back(first.doc);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+double NoteSearchIndex::score_document(uint32_t doc, const std::vector<std::string>& terms) const {
+    double doc_count = static_cast<double>(documents.size());
+    double average_length = documents.empty() ? 1.0 : static_cast<double>(total_length) / doc_count;
+    if (average_length <= 0.0) average_length = 1.0;
+    double length_norm = 1.0 - BM25_B + BM25_B * (document_lengths[doc] / average_length);
+
+    double score = 0.0;
+    for (const auto& term : terms) {
+        const std::vector<Posting>* list = find_postings(term);
+        if (!list) continue;
+        auto it = std::lower_bound(list->begin(), list->end(), doc,
+                                   [](const Posting& p, uint32_t d) { return p.doc < d; });
+        if (it == list->end() || it->doc != doc) continue;
+
+        double df = static_cast<double>(list->size());
+        double idf = std::log(1.0 + (doc_count - df + 0.5) / (df + 0.5));
+        double tf = static_cast<double>(it->positions.size());
+        score += idf * (tf * (BM25_K1 + 1.0)) / (tf + BM25_K1 * length_norm);
+    }
+    return score;
+}
+
+std::vector<NoteSearchHit> NoteSearchIndex::search(const std::string& query, size_t limit) const {
+    std::vector<NoteSearchHit> hits;
+
+    // Parse: `groups` are ANDed together, the clauses inside a group are ORed.
+    std::vector<std::vector<Clause>> groups;
+    std::vector<Clause> excluded;
+    bool pending_or = false;
+    size_t i = 0;
+    while (i < query.size()) {
+        if (query[i] == ' ' || query[i] == '\t') { ++i; continue; }
+
+        bool negate = false;
+        if (query[i] == '-' && i + 1 < query.size() && query[i + 1] != ' ') {
+            negate = true;
+            ++i;
+        }
+
+        std::string raw;
+        bool quoted = false;
+        if (query[i] == '"') {
+            quoted = true;
+            size_t end = query.find('"', i + 1);
+            if (end == std::string::npos) end = query.size();
+            raw = query.substr(i + 1, end - i - 1);
+            i = end + 1;
+        } else {
+            size_t end = query.find_first_of(" \t", i);
+            if (end == std::string::npos) end = query.size();
+            raw = query.substr(i, end - i);
+            i = end;
+        }
+
+        if (!quoted && !negate) {
+            if (raw == "OR") { pending_or = true; continue; }
+            if (raw == "AND") continue;
+        }
+
+        Clause clause;
+        tokenize(raw.data(), raw.size(), clause); // A word like "don't" becomes the phrase "don t"
+        if (clause.empty()) continue;
+
+        if (negate) {
+            excluded.push_back(clause);
+        } else if (pending_or && !groups.empty()) {
+            groups.back().push_back(clause);
+        } else {
+            groups.push_back(std::vector<Clause>(1, clause));
+        }
+        pending_or = false;
+    }
+    if (groups.empty() || limit == 0) return hits;
+
+    // Evaluate each OR group, then intersect the groups smallest first.
+    std::vector<std::vector<uint32_t>> group_docs;
+    for (const auto& group : groups) {
+        std::vector<uint32_t> docs;
+        for (const auto& clause : group) {
+            std::vector<uint32_t> matched = match_clause(clause);
+            std::vector<uint32_t> merged;
+            std::set_union(docs.begin(), docs.end(), matched.begin(), matched.end(), std::back_inserter(merged));
+            docs.swap(merged);
+        }
+        if (docs.empty()) return hits;
+        group_docs.push_back(docs);
+    }
+    std::sort(group_docs.begin(), group_docs.end(),
+              [](const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) { return a.size() < b.size(); });
+    std::vector<uint32_t> candidates = group_docs[0];
+    for (size_t g = 1; g < group_docs.size() && !candidates.empty(); ++g) {
+        std::vector<uint32_t> narrowed;
+        std::set_intersection(candidates.begin(), candidates.end(), group_docs[g].begin(), group_docs[g].end(),
+                              std::back_inserter(narrowed));
+        candidates.swap(narrowed);
+    }
+    for (const auto& clause : excluded) {
+        if (candidates.empty()) break;
+        std::vector<uint32_t> unwanted = match_clause(clause);
+        std::vector<uint32_t> kept;
+        std::set_difference(candidates.begin(), candidates.end(), unwanted.begin(), unwanted.end(),
+                            std::back_inserter(kept));
+        candidates.swap(kept);
+    }
+
+    // Every positive term contributes to the score, once.
+    std::vector<std::string> scored_terms;
+    for (const auto& group : groups) {
+        for (const auto& clause : group) {
+            scored_terms.insert(scored_terms.end(), clause.begin(), clause.end());
+        }
+    }
+    std::sort(scored_terms.begin(), scored_terms.end());
+    scored_terms.erase(std::unique(scored_terms.begin(), scored_terms.end()), scored_terms.end());
+
+    hits.reserve(candidates.size());
+    for (uint32_t doc : candidates) {
+        NoteSearchHit hit = {documents[doc].notebook_index, documents[doc].note_index, score_document(doc, scored_terms)};
+        hits.push_back(hit);
+    }
+
+    auto better = [](const NoteSearchHit& a, const NoteSearchHit& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.notebook_index != b.notebook_index) return a.notebook_index < b.notebook_index;
+        return a.note_index < b.note_index;
+    };
+    if (hits.size() > limit) {
+        std::partial_sort(hits.begin(), hits.begin() + limit, hits.end(), better);
+        hits.resize(limit);
+    } else {
+        std::sort(hits.begin(), hits.end(), better);
+    }
+    return hits;
+}
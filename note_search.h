@@ -0,0 +1,65 @@
+#ifndef NOTE_SEARCH_H
+#define NOTE_SEARCH_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "study_core.h" // For Note, Notebook
+
+// --- Full-text search over notebook notes ---
+// An inverted index maps each term to a posting list of (note, positions).
+// Terms are lowercase runs of letters and digits taken from the topic title
+// and the content of every note.
+//
+// Query syntax:
+//   word word         both words must appear (AND is implied; "AND" is accepted)
+//   word OR word      either word may appear
+//   "some phrase"     the words must appear next to each other, in order
+//   -word, -"phrase"  notes containing it are excluded
+// Matches are ranked with BM25.
+
+struct NoteSearchHit {
+    size_t notebook_index; // Index into notebooks
+    size_t note_index;     // Index into notebooks[notebook_index].notes
+    double score;
+};
+
+class NoteSearchIndex {
+public:
+    NoteSearchIndex() : total_length(0) {}
+
+    void clear();
+    void build(const std::vector<Notebook>& all_notebooks); // Re-indexes every note
+    void add_note(size_t notebook_index, size_t note_index, const Note& note);
+
+    // Best `limit` matches for `query`, highest score first. Empty on no match or an empty query.
+    std::vector<NoteSearchHit> search(const std::string& query, size_t limit = 10) const;
+
+    size_t document_count() const { return documents.size(); }
+
+private:
+    struct Posting {
+        uint32_t doc;
+        std::vector<uint32_t> positions; // Ascending
+    };
+    struct DocumentRef {
+        size_t notebook_index;
+        size_t note_index;
+    };
+    // A query clause: one term, or several terms forming a phrase.
+    typedef std::vector<std::string> Clause;
+
+    const std::vector<Posting>* find_postings(const std::string& term) const;
+    std::vector<uint32_t> match_clause(const Clause& clause) const;
+    double score_document(uint32_t doc, const std::vector<std::string>& terms) const;
+
+    std::unordered_map<std::string, std::vector<Posting>> postings; // Each list is sorted by doc
+    std::vector<DocumentRef> documents;                               // doc id -> note
+    std::vector<uint32_t> document_lengths;                           // doc id -> term count
+    uint64_t total_length;
+};
+
+extern NoteSearchIndex note_search_index; // Kept in step with notebooks
+
+#endif // NOTE_SEARCH_H
@@ -0,0 +1,58 @@
+#include "review_queue.h"
+#include "study_core.h"
+#include "file_handler.h"      // For flashcard_decks
+#include "spaced_repetition.h" // For sync_due_index
+#include "subject_registry.h"  // For subject_registry.decks_for
+#include <queue>               // For std::priority_queue
+#include <functional>          // For std::greater
+#include <iterator>            // For std::next
+#include <tuple>               // For std::tie
+
+// Heap entry: the next due card of one deck.
+struct MergeCursor {
+    int due_day;
+    size_t deck_index;
+    size_t card_index;
+    std::set<std::pair<int, size_t> >::const_iterator next; // Entry after this one in the deck's due index
+
+    bool operator>(const MergeCursor& other) const {
+        return std::tie(due_day, deck_index, card_index) > std::tie(other.due_day, other.deck_index, other.card_index);
+    }
+};
+
+std::vector<ReviewItem> build_review_queue(int today, const std::string& subject_filter, size_t limit) {
+    std::vector<Deck>& decks = flashcard_decks;
+    std::vector<size_t> deck_indices;
+    if (subject_filter.empty()) {
+        deck_indices.reserve(decks.size());
+        for (size_t i = 0; i < decks.size(); ++i) deck_indices.push_back(i);
+    } else {
+        deck_indices = subject_registry.decks_for(subject_filter);
+    }
+
+    std::priority_queue<MergeCursor, std::vector<MergeCursor>, std::greater<MergeCursor> > heap;
+    for (size_t deck_index : deck_indices) {
+        if (deck_index >= decks.size()) continue;
+        Deck& deck = decks[deck_index];
+        sync_due_index(deck);
+        auto first = deck.due_index.begin();
+        if (first == deck.due_index.end() || first->first > today) continue; // Nothing due in this deck
+        MergeCursor cursor = {first->first, deck_index, first->second, std::next(first)};
+        heap.push(cursor);
+    }
+
+    std::vector<ReviewItem> queue;
+    while (!heap.empty() && (limit == 0 || queue.size() < limit)) {
+        MergeCursor cursor = heap.top();
+        heap.pop();
+        ReviewItem item = {cursor.deck_index, cursor.card_index, cursor.due_day};
+        queue.push_back(item);
+
+        const Deck& deck = decks[cursor.deck_index];
+        if (cursor.next != deck.due_index.end() && cursor.next->first <= today) {
+            MergeCursor following = {cursor.next->first, cursor.deck_index, cursor.next->second, std::next(cursor.next)};
+            heap.push(following);
+        }
+    }
+    return queue;
+}
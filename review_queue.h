@@ -0,0 +1,26 @@
+#ifndef REVIEW_QUEUE_H
+#define REVIEW_QUEUE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// --- Cross-deck review queue ---
+// Every deck already keeps its cards sorted by due day (Deck::due_index), so
+// the cards due across all decks are a k-way merge of those sorted lists: a
+// heap holds the next due card of each deck and yields them earliest first.
+// Building a queue of m cards from k decks costs O(k + m log k), and decks
+// with nothing due drop out after one look.
+
+struct ReviewItem {
+    size_t deck_index; // Index into flashcard_decks
+    size_t card_index; // Index into that deck's cards
+    int due_day;
+};
+
+// Cards due on or before `today` across flashcard_decks, earliest due first (ties by deck, then card).
+// A non-empty subject_filter limits the merge to that subject's decks (found via subject_registry).
+// limit == 0 returns every due card.
+std::vector<ReviewItem> build_review_queue(int today, const std::string& subject_filter = "", size_t limit = 0);
+
+#endif // REVIEW_QUEUE_H
@@ -0,0 +1,250 @@
+#include "scheduler_core.h"
+#include "file_handler.h"     // For the classSchedule and tasks declarations
+#include "subject_registry.h" // For subject_registry
+#include "utils.h"            // For minutesToTimeString
+#include <algorithm>          // For std::sort, std::max
+#include <limits>             // For std::numeric_limits
+
+// Definition of global data vectors for scheduler and planner
+std::vector<ClassDetails> classSchedule;
+std::vector<TaskDetails> tasks;
+MonotonicArena tasksArena;
+static size_t removedTasks = 0; // Slots in tasks marked removed
+
+void clearTasks() {
+    tasks.clear();
+    removedTasks = 0;
+    tasksArena.release();
+}
+
+size_t taskCount() {
+    return tasks.size() - removedTasks;
+}
+
+void compactTasks() {
+    if (removedTasks == 0) return;
+    tasks.erase(std::remove_if(tasks.begin(), tasks.end(), [](const TaskDetails& task) { return task.removed; }),
+                tasks.end());
+    removedTasks = 0; // The removed tasks' text stays in tasksArena until the next clearTasks
+    rebuildTaskPriorityIndex();
+    rebuild_task_subjects();
+}
+
+// --- Class Conflict Index Implementation ---
+ClassConflictIndex classConflictIndex;
+
+ClassConflictIndex::ClassConflictIndex() {
+    clear();
+}
+
+void ClassConflictIndex::clear() {
+    for (int d = 0; d < 7; ++d) {
+        byStart[d].clear();
+        for (int b = 0; b < DURATION_BUCKETS; ++b) byDuration[d][b].clear();
+    }
+}
+
+// floor(log2(duration)) for a duration of 1 to 2047 minutes
+static int durationBucket(int duration) {
+    int bucket = 0;
+    while (duration >>= 1) ++bucket;
+    return bucket;
+}
+
+// Removes the entry for `classIndex` among those starting at `startMinutes`.
+static void eraseMeeting(ClassConflictIndex::Meetings& meetings, int startMinutes, size_t classIndex) {
+    auto range = meetings.equal_range(startMinutes);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.classIndex == classIndex) {
+            meetings.erase(it);
+            return;
+        }
+    }
+}
+
+void ClassConflictIndex::insert(size_t classIndex, const ClassDetails& cls) {
+    int startMinutes = cls.startMinutes;
+    int endMinutes = cls.endMinutes;
+    if (startMinutes == -1 || endMinutes == -1 || startMinutes >= endMinutes) {
+        return; // Invalid ranges can never overlap anything; nothing to index
+    }
+    int bucket = durationBucket(endMinutes - startMinutes);
+    for (int d = 0; d < 7; ++d) {
+        if (!(cls.dayMask & (1u << d))) continue;
+        ClassInterval interval = {startMinutes, endMinutes, classIndex};
+        byStart[d].insert(std::make_pair(startMinutes, interval));
+        byDuration[d][bucket].insert(std::make_pair(startMinutes, interval));
+    }
+}
+
+void ClassConflictIndex::erase(size_t classIndex, const ClassDetails& cls) {
+    int startMinutes = cls.startMinutes;
+    int endMinutes = cls.endMinutes;
+    if (startMinutes == -1 || endMinutes == -1 || startMinutes >= endMinutes) return; // Never indexed
+    int bucket = durationBucket(endMinutes - startMinutes);
+    for (int d = 0; d < 7; ++d) {
+        if (!(cls.dayMask & (1u << d))) continue;
+        eraseMeeting(byStart[d], startMinutes, classIndex);
+        eraseMeeting(byDuration[d][bucket], startMinutes, classIndex);
+    }
+}
+
+std::vector<size_t> ClassConflictIndex::findConflicts(const ClassDetails& cls, int ignoreIndex) const {
+    std::vector<size_t> conflicts;
+    int startMinutes = cls.startMinutes;
+    int endMinutes = cls.endMinutes;
+    if (startMinutes == -1 || endMinutes == -1 || startMinutes >= endMinutes) {
+        return conflicts;
+    }
+    for (int d = 0; d < 7; ++d) {
+        if (!(cls.dayMask & (1u << d))) continue;
+        for (int b = 0; b < DURATION_BUCKETS; ++b) {
+            const Meetings& bucket = byDuration[d][b];
+            if (bucket.empty()) continue;
+            // Meetings in bucket b last under 2^(b+1) minutes, so anything starting
+            // at or before startMinutes - 2^(b+1) has already ended.
+            auto it = bucket.upper_bound(startMinutes - (1 << (b + 1)));
+            auto last = bucket.lower_bound(endMinutes);
+            for (; it != last; ++it) {
+                const ClassInterval& existing = it->second;
+                if (static_cast<int>(existing.classIndex) == ignoreIndex) continue;
+                if (existing.endMinutes > startMinutes) {
+                    conflicts.push_back(existing.classIndex);
+                }
+            }
+        }
+    }
+    std::sort(conflicts.begin(), conflicts.end());
+    conflicts.erase(std::unique(conflicts.begin(), conflicts.end()), conflicts.end());
+    return conflicts;
+}
+
+void rebuildClassConflictIndex() {
+    classConflictIndex.clear();
+    for (size_t i = 0; i < classSchedule.size(); ++i) {
+        classConflictIndex.insert(i, classSchedule[i]);
+    }
+}
+
+size_t appendClass(const ClassDetails& cls) {
+    classSchedule.push_back(cls);
+    classConflictIndex.insert(classSchedule.size() - 1, cls);
+    subject_registry.add_class(classSchedule.size() - 1, cls.subject);
+    return classSchedule.size() - 1;
+}
+
+// --- Task Priority Index Implementation ---
+TaskPriorityIndex taskPriorityIndex;
+
+void TaskPriorityIndex::clear() {
+    byPriority.clear();
+    byDeadline.clear();
+}
+
+void TaskPriorityIndex::insert(size_t taskIndex, const TaskDetails& task) {
+    byPriority.insert(std::make_tuple(task.completed, task.urgency, task.deadline.dayNumber, taskIndex));
+    byDeadline.insert(std::make_tuple(task.completed, task.deadline.dayNumber, taskIndex));
+}
+
+void TaskPriorityIndex::erase(size_t taskIndex, const TaskDetails& task) {
+    byPriority.erase(std::make_tuple(task.completed, task.urgency, task.deadline.dayNumber, taskIndex));
+    byDeadline.erase(std::make_tuple(task.completed, task.deadline.dayNumber, taskIndex));
+}
+
+std::vector<size_t> TaskPriorityIndex::pendingByPriority(size_t limit) const {
+    std::vector<size_t> result;
+    for (auto it = byPriority.begin(); it != byPriority.end() && !std::get<0>(*it); ++it) {
+        if (limit != 0 && result.size() == limit) break;
+        result.push_back(std::get<3>(*it));
+    }
+    return result;
+}
+
+std::vector<size_t> TaskPriorityIndex::pendingDueBy(CivilDate lastDay) const {
+    return pendingDueBetween(CivilDate(std::numeric_limits<int>::min()), lastDay);
+}
+
+std::vector<size_t> TaskPriorityIndex::pendingDueBetween(CivilDate firstDay, CivilDate lastDay) const {
+    std::vector<size_t> result;
+    if (lastDay < firstDay) return result;
+    auto it = byDeadline.lower_bound(std::make_tuple(false, firstDay.dayNumber, size_t(0)));
+    for (; it != byDeadline.end() && !std::get<0>(*it) && std::get<1>(*it) <= lastDay.dayNumber; ++it) {
+        result.push_back(std::get<2>(*it));
+    }
+    return result;
+}
+
+std::vector<size_t> TaskPriorityIndex::pendingOverdueBy(CivilDate today, int days) const {
+    if (!today.isValid()) return std::vector<size_t>();
+    if (days < 0) days = 0;
+    return pendingDueBy(today.plusDays(-days - 1));
+}
+
+void TaskPriorityIndex::assign(const std::vector<TaskDetails>& allTasks) {
+    // Sorting first lets the sets be built from ordered ranges in linear time,
+    // instead of one O(log n) rebalancing insert per task.
+    std::vector<std::tuple<bool, int, int, size_t> > priority;
+    std::vector<std::tuple<bool, int, size_t> > deadline;
+    priority.reserve(allTasks.size());
+    deadline.reserve(allTasks.size());
+    for (size_t i = 0; i < allTasks.size(); ++i) {
+        if (allTasks[i].removed) continue;
+        int deadlineDay = allTasks[i].deadline.dayNumber;
+        priority.push_back(std::make_tuple(allTasks[i].completed, allTasks[i].urgency, deadlineDay, i));
+        deadline.push_back(std::make_tuple(allTasks[i].completed, deadlineDay, i));
+    }
+    std::sort(priority.begin(), priority.end());
+    std::sort(deadline.begin(), deadline.end());
+    byPriority = std::set<std::tuple<bool, int, int, size_t> >(priority.begin(), priority.end());
+    byDeadline = std::set<std::tuple<bool, int, size_t> >(deadline.begin(), deadline.end());
+}
+
+void rebuildTaskPriorityIndex() {
+    taskPriorityIndex.assign(tasks);
+}
+
+size_t appendTask(const TaskDetails& task) {
+    tasks.push_back(task);
+    taskPriorityIndex.insert(tasks.size() - 1, task);
+    subject_registry.add_task(tasks.size() - 1, task.subject);
+    return tasks.size() - 1;
+}
+
+void completeTaskAt(size_t taskIndex) {
+    if (tasks[taskIndex].completed || tasks[taskIndex].removed) return;
+    taskPriorityIndex.erase(taskIndex, tasks[taskIndex]);
+    tasks[taskIndex].completed = true;
+    taskPriorityIndex.insert(taskIndex, tasks[taskIndex]);
+}
+
+void removeTaskAt(size_t taskIndex) {
+    if (tasks[taskIndex].removed) return;
+    taskPriorityIndex.erase(taskIndex, tasks[taskIndex]);
+    subject_registry.remove_task(taskIndex, tasks[taskIndex].subject);
+    tasks[taskIndex].removed = true;
+    // Compacting after n/2 removals keeps the O(n) pass at O(1) per removal
+    if (++removedTasks * 2 > tasks.size()) compactTasks();
+}
+
+std::string urgencyToString(int urgency) {
+    switch (urgency) {
+        case 1: return "High";
+        case 2: return "Moderate";
+        case 3: return "Low";
+        default: return "Unknown";
+    }
+}
+
+std::string taskDeadlineText(const TaskDetails& task) {
+    return !task.deadline.isValid() && !task.unparsedDeadline.empty() ? task.unparsedDeadline.str() : task.deadline.toString();
+}
+
+std::string classTimeText(int minutes, const std::string& unparsed) {
+    return minutes == -1 && !unparsed.empty() ? unparsed : minutesToTimeString(minutes);
+}
+
+// Unique subject names from the class schedule, sorted. Maintained by subject_registry
+// as classes are added and edited, so nothing is rebuilt per call.
+const std::vector<std::string>& get_scheduler_subjects() {
+    return subject_registry.class_subjects();
+}
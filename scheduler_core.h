@@ -0,0 +1,144 @@
+#ifndef SCHEDULER_CORE_H
+#define SCHEDULER_CORE_H
+
+#include <string>
+#include <vector>
+#include <set>      // For std::set in TaskPriorityIndex
+#include <map>      // For std::multimap in ClassConflictIndex
+#include <tuple>    // For TaskPriorityIndex keys
+#include "arena.h" // For StringRef and MonotonicArena
+#include "civil_date.h" // For CivilDate deadlines
+
+// Scheduler data, its indexes and the mutations that keep them in sync. Part of
+// libiskaalaman_core: nothing here reads from or writes to the console; the
+// menus in scheduler_planner.h are a front-end over it.
+
+// --- Data structures ---
+struct ClassDetails {
+    std::string subject;
+    unsigned char dayMask;   // Bit d set if the class meets on tm_wday d (see utils.h)
+    int startMinutes;        // Minutes since midnight, parsed once at input/load time; -1 if invalid
+    int endMinutes;
+    std::string venue;
+    // Text of a start/end time that failed to parse at load; saved back in place of
+    // "--:--" while the matching minutes stay -1, so a bad file line isn't lost.
+    std::string unparsedStart;
+    std::string unparsedEnd;
+
+    ClassDetails() : dayMask(0), startMinutes(-1), endMinutes(-1) {}
+};
+
+struct TaskDetails {
+    StringRef name;          // Bytes owned by tasksArena
+    std::string subject;     // Kept owning: it keys subject_registry and is usually short
+    StringRef infos;         // Bytes owned by tasksArena
+    CivilDate deadline;      // Saved as "YYYY-MM-DD"; invalid only for tasks loaded from older, unvalidated files
+    StringRef unparsedDeadline; // Bytes owned by tasksArena: the text of an invalid deadline, saved back unchanged
+    int urgency;             // 1:High, 2:Moderate, 3:Low
+    bool completed;
+    bool removed;            // Deleted; the slot stays until compactTasks so later indices don't move
+
+    TaskDetails() : urgency(3), completed(false), removed(false) {}
+};
+
+// --- Class conflict index ---
+// Per-weekday index of class meeting intervals, keyed by start minute.
+// For conflict queries each weekday's meetings are also split into duration
+// buckets (bucket b holds durations in [2^b, 2^(b+1))). A meeting in bucket b
+// that overlaps [start, end) must start before `end` and after
+// `start - 2^(b+1)`, so a query visits one short window per bucket: O(log n)
+// plus the overlaps found, however long the longest class is. In a
+// conflict-free schedule each window holds at most a couple of meetings that
+// turn out not to overlap.
+struct ClassInterval {
+    int startMinutes;
+    int endMinutes;
+    size_t classIndex; // Position in classSchedule
+};
+
+class ClassConflictIndex {
+public:
+    typedef std::multimap<int, ClassInterval> Meetings; // Start minute -> interval
+
+    ClassConflictIndex();
+    void clear();
+    void insert(size_t classIndex, const ClassDetails& cls);
+    void erase(size_t classIndex, const ClassDetails& cls); // cls must be the version that was inserted
+    // Returns the classSchedule indices of every class overlapping `cls` on a common day,
+    // sorted and without duplicates. `ignoreIndex` skips the class being edited.
+    std::vector<size_t> findConflicts(const ClassDetails& cls, int ignoreIndex = -1) const;
+    // Classes meeting on a weekday (0=Sun .. 6=Sat), ordered by start time; this
+    // doubles as the weekly timetable the term calendar expands (term_calendar.h).
+    // Classes with an invalid time range are not indexed.
+    const Meetings& meetingsOn(int weekday) const { return byStart[weekday]; }
+
+private:
+    static const int DURATION_BUCKETS = 11; // 2^11 minutes is more than a day
+
+    Meetings byStart[7]; // 0=Sun .. 6=Sat, matching tm_wday
+    Meetings byDuration[7][DURATION_BUCKETS]; // The same meetings, by duration bucket
+};
+
+extern ClassConflictIndex classConflictIndex;
+void rebuildClassConflictIndex(); // Re-index all of classSchedule (after loading)
+
+// --- Task priority index ---
+// Ordered views over the live (not removed) entries of `tasks`, kept current on
+// every add/complete/delete, so listing
+// pending work never re-sorts the whole vector. Completed tasks sort after all
+// pending ones, so pending queries only walk the prefix they return.
+class TaskPriorityIndex {
+public:
+    void clear();
+    void assign(const std::vector<TaskDetails>& allTasks); // Re-index everything; O(n log n) with a cheap linear build
+    void insert(size_t taskIndex, const TaskDetails& task);
+    void erase(size_t taskIndex, const TaskDetails& task); // task must be the version that was inserted
+
+    // Pending tasks ordered by urgency, then deadline. limit == 0 returns all of them.
+    std::vector<size_t> pendingByPriority(size_t limit = 0) const;
+    // Pending tasks due on or before lastDay (overdue ones included), ordered by deadline.
+    std::vector<size_t> pendingDueBy(CivilDate lastDay) const;
+    // Pending tasks due in [firstDay, lastDay], ordered by deadline. A range
+    // lookup in byDeadline: the cost is O(log n + matches), not a scan of tasks.
+    std::vector<size_t> pendingDueBetween(CivilDate firstDay, CivilDate lastDay) const;
+    // Pending tasks whose deadline passed more than `days` days before today.
+    std::vector<size_t> pendingOverdueBy(CivilDate today, int days) const;
+
+private:
+    // (completed, urgency, deadline day, index) and (completed, deadline day, index)
+    std::set<std::tuple<bool, int, int, size_t> > byPriority;
+    std::set<std::tuple<bool, int, size_t> > byDeadline;
+};
+
+extern TaskPriorityIndex taskPriorityIndex;
+void rebuildTaskPriorityIndex();
+
+// Owns the name and infos bytes of every task, so loading tasks.dat costs a few
+// block allocations instead of two per task. New tasks copy their text in
+// (tasksArena.copy) before appendTask. Released only by clearTasks, so a
+// task's StringRefs stay valid for as long as it is in `tasks`.
+extern MonotonicArena tasksArena;
+void clearTasks(); // Empties tasks and releases tasksArena; callers rebuild the indexes
+
+// Deleting a task only marks its slot removed and drops its own index keys, so
+// every other task keeps its index. The slots are squeezed out in one O(n) pass
+// once they outnumber the live tasks, and whenever tasks.dat is written, so the
+// journal's indices always count from the snapshot's order.
+size_t taskCount();   // Live tasks; tasks.size() also counts removed slots
+void compactTasks();  // Drops removed slots and re-indexes; invalidates task indices held by callers
+
+// Class and task mutations shared by the menus, batch commands and journal replay;
+// they keep the indexes and subject_registry current.
+size_t appendClass(const ClassDetails& cls); // Does not check for conflicts; see ClassConflictIndex::findConflicts
+size_t appendTask(const TaskDetails& task);
+void completeTaskAt(size_t taskIndex);
+void removeTaskAt(size_t taskIndex); // Keeps the order of the rest; O(log n) plus amortized compaction
+
+std::string urgencyToString(int urgency); // 1 -> "High", 2 -> "Moderate", 3 -> "Low"
+// A deadline as saved, journaled and exported: the original text while it is unparsable.
+std::string taskDeadlineText(const TaskDetails& task);
+// A class time as saved, journaled and exported: the original text while it is unparsable.
+std::string classTimeText(int minutes, const std::string& unparsed);
+const std::vector<std::string>& get_scheduler_subjects(); // Sorted; from subject_registry
+
+#endif // SCHEDULER_CORE_H
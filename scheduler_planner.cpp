@@ -1,641 +1,960 @@
-#include "scheduler_planner.h"
-#include "utils.h"        // For various utility functions
-#include "file_handler.h" // For saving/loading schedule and tasks
-#include <algorithm>      // For std::sort, std::transform
-#include <limits>         // For std::numeric_limits
-#include <sstream>        // For std::stringstream in addClass (day parsing, though primary parsing is in utils)
-#include <iomanip>        // For std::put_time (though this is now in utils.cpp) - remove if not directly used
-
-// Definition of global data vectors for scheduler and planner
-std::vector<ClassDetails> classSchedule;
-std::vector<TaskDetails> tasks;
-
-// --- Calendar Implementation ---
-void displayCalendar() {
-    std::string today_s_date = getCurrentDateYYYYMMDD();
-    std::string current_day_of_week = getCurrentDayOfWeek();
-
-    std::cout << "\n--- Calendar ---" << std::endl;
-    std::cout << "Today's Date: " << today_s_date << " (" << current_day_of_week << ")" << std::endl;
-
-    std::cout << "\n--- Today's Classes (" << current_day_of_week << ") ---" << std::endl;
-    bool found_class_today = false;
-    int class_display_count = 1;
-    if (!classSchedule.empty()) {
-        for (const auto& cls : classSchedule) {
-            bool scheduled_for_today = false;
-            for (const auto& day : cls.daysOfWeek) {
-                if (day == current_day_of_week) {
-                    scheduled_for_today = true;
-                    break;
-                }
-            }
-            if (scheduled_for_today) {
-                if (!found_class_today) found_class_today = true;
-                std::cout << class_display_count++ << ". Subject: " << cls.subject
-                          << ", Start: " << cls.startTime
-                          << ", End: " << cls.endTime
-                          << ", Venue: " << cls.venue << std::endl;
-            }
-        }
-    }
-    if (!found_class_today) {
-        std::cout << "<No classes scheduled for today>" << std::endl;
-    }
-
-    std::cout << "\n--- Today's Tasks (Due Today or Overdue and Not Completed) ---" << std::endl;
-    bool found_task_for_today = false;
-    int task_display_count = 1;
-    // Ensure tasks is accessible, might need to be passed or made available if not global
-    for (size_t i = 0; i < tasks.size(); ++i) {
-        if (!tasks[i].completed && tasks[i].deadlineDate <= today_s_date) {
-            if (!found_task_for_today) found_task_for_today = true;
-            std::cout << task_display_count++ << ". Name: " << tasks[i].name
-                      << " | Subject: " << tasks[i].subject
-                      << " | Deadline: " << tasks[i].deadlineDate
-                      << " | Urgency: " << urgencyToString(tasks[i].urgency)
-                      << " | Infos: " << tasks[i].infos
-                      << std::endl;
-        }
-    }
-    if (!found_task_for_today) {
-        std::cout << "<No tasks due today or overdue>" << std::endl;
-    }
-
-    std::cout << "\nPress Enter to return to the menu...";
-    clear_input_buffer(); // From utils.h
-    // Wait for a new line
-    std::string dummy;
-    std::getline(std::cin, dummy);
-}
-
-// --- Menu Display Functions for Scheduler/Planner ---
-void displaySchedulerPlannerMenu() {
-    std::cout << "\nISKAALAMAN Scheduler and Planner Menu:" << std::endl;
-    std::cout << "1. Calendar" << std::endl;
-    std::cout << "2. Class Scheduler" << std::endl;
-    std::cout << "3. Task Manager" << std::endl;
-    std::cout << "4. Back to Main Menu" << std::endl;
-    std::cout << "Enter your choice (1-4): ";
-}
-
-void displayClassScheduleMenu() {
-    std::cout << "\n--- Class Schedule ---" << std::endl;
-    displayClassSchedule(); // Assumes this is now part of scheduler_planner.cpp
-    std::cout << "\nClass Scheduler Options:" << std::endl;
-    std::cout << "1. Add Class" << std::endl;
-    std::cout << "2. Edit Class" << std::endl;
-    std::cout << "3. Back to Scheduler/Planner Menu" << std::endl;
-    std::cout << "Enter your choice (1-3): ";
-}
-
-void displayTaskManagerMenu() {
-    std::cout << "\n--- Task Manager ---" << std::endl;
-    std::cout << "1. Show Tasks" << std::endl;
-    std::cout << "2. Add Task" << std::endl;
-    std::cout << "3. Delete Task" << std::endl;
-    std::cout << "4. Back to Scheduler/Planner Menu" << std::endl;
-    std::cout << "Enter your choice (1-4): ";
-}
-
-// --- Class Scheduler Implementation ---
-void displayClassSchedule() {
-    if (classSchedule.empty()) {
-        std::cout << "<no class schedule is available>" << std::endl;
-    } else {
-        std::cout << "Current Class Schedule:" << std::endl;
-        for (size_t i = 0; i < classSchedule.size(); ++i) {
-            std::cout << i + 1 << ". Subject: " << classSchedule[i].subject << ", Days: ";
-            if (classSchedule[i].daysOfWeek.empty()) {
-                std::cout << "N/A";
-            } else {
-                for (size_t j = 0; j < classSchedule[i].daysOfWeek.size(); ++j) {
-                    std::cout << classSchedule[i].daysOfWeek[j] << (j < classSchedule[i].daysOfWeek.size() - 1 ? "," : "");
-                }
-            }
-            std::cout << ", Start: " << classSchedule[i].startTime
-                      << ", End: " << classSchedule[i].endTime
-                      << ", Venue: " << classSchedule[i].venue << std::endl;
-        }
-    }
-}
-
-void addClass() {
-    ClassDetails newClass;
-    std::cout << "--- Add New Class ---" << std::endl;
-    clear_input_buffer(); // From utils.h
-
-    std::cout << "Enter Subject: ";
-    std::getline(std::cin, newClass.subject);
-
-    while(true) {
-        std::cout << "Enter Start Time (e.g., 09:00 AM): ";
-        std::getline(std::cin, newClass.startTime);
-        if (isValidTimeFormat(newClass.startTime)) break; // from utils.h
-        std::cout << "<Invalid time format. Please use HH:MM AM/PM (e.g., 09:30 AM).>" << std::endl;
-    }
-
-    while(true) {
-        std::cout << "Enter End Time (e.g., 10:00 AM): ";
-        std::getline(std::cin, newClass.endTime);
-        if (isValidTimeFormat(newClass.endTime)) break; // from utils.h
-        std::cout << "<Invalid time format. Please use HH:MM AM/PM (e.g., 09:30 AM).>" << std::endl;
-    }
-
-    bool daysParsedSuccessfully = false;
-    std::string daysInput;
-    while(!daysParsedSuccessfully){
-        std::cout << "Enter Days of Week (e.g., Mon,Wed,Fri or M,T,W,TH,F,Sat,Sun): ";
-        std::getline(std::cin, daysInput);
-        if (daysInput.empty()){
-            std::cout << "<Days of week cannot be empty when adding a new class.>" << std::endl;
-            continue;
-        }
-        if (parseDaysOfWeek(daysInput, newClass.daysOfWeek)) { // parseDaysOfWeek from utils.h
-            if (newClass.daysOfWeek.empty() && !daysInput.empty()) {
-                std::cout << "<No valid days were recognized. Please check format (e.g., Mon,Tue,Wed).>" << std::endl;
-            } else if (newClass.daysOfWeek.empty() && daysInput.empty()) {
-                // This case should ideally not be hit if daysInput.empty() is checked above.
-                // However, if parseDaysOfWeek can somehow result in empty daysOfWeek for an empty daysInput (e.g. only whitespace)
-                // and still return true, this could be a fallback.
-                // For addClass, empty days are an error.
-                std::cout << "<No days entered. Please enter days for the class.>" << std::endl;
-            }
-            else { // Valid days parsed and daysOfWeek is not empty
-                daysParsedSuccessfully = true;
-            }
-        } else {
-            std::cout << "<Invalid day format or unrecognized day(s) entered. Please use formats like Mon,Tue,Wed or M,T,W,TH,F,Sat,Sun.>" << std::endl;
-        }
-    }
-
-    std::cout << "Enter Venue: ";
-    std::getline(std::cin, newClass.venue);
-
-    if (checkClassConflict(newClass, -1)) { // checkClassConflict is now part of scheduler_planner.cpp
-        // Error message printed by checkClassConflict
-    } else {
-        classSchedule.push_back(newClass);
-        std::cout << "Class '" << newClass.subject << "' added successfully." << std::endl;
-        saveClassScheduleToFile(); // from file_handler.h
-    }
-}
-
-bool checkClassConflict(const ClassDetails& classToValidate, int editingClassIndex) {
-    int newStartTimeMinutes = timeToMinutes(classToValidate.startTime); // from utils.h
-    int newEndTimeMinutes = timeToMinutes(classToValidate.endTime);   // from utils.h
-
-    if (newStartTimeMinutes == -1 || newEndTimeMinutes == -1) {
-        // This implies an invalid format that wasn't caught by initial input validation,
-        // or data was corrupted. isValidTimeFormat (called by timeToMinutes) should prevent this.
-        std::cout << "<Internal Error: Invalid time format in class being validated. Conflict check aborted.>" << std::endl;
-        return true; // Treat as conflict to be safe
-    }
-
-    if (newStartTimeMinutes >= newEndTimeMinutes) {
-        std::cout << "<Start time must be before end time. Class not added/updated.>" << std::endl;
-        return true;
-    }
-
-    for (size_t i = 0; i < classSchedule.size(); ++i) {
-        if (static_cast<int>(i) == editingClassIndex) {
-            continue;
-        }
-        const auto& existingClass = classSchedule[i];
-        int existingStartTimeMinutes = timeToMinutes(existingClass.startTime);
-        int existingEndTimeMinutes = timeToMinutes(existingClass.endTime);
-
-        if (existingStartTimeMinutes == -1 || existingEndTimeMinutes == -1) {
-            std::cout << "<Warning: Existing class '" << existingClass.subject << "' has invalid time format. Skipping for conflict check.>" << std::endl;
-            continue;
-        }
-
-        bool commonDayFound = false;
-        for (const auto& newDay : classToValidate.daysOfWeek) {
-            for (const auto& existingDay : existingClass.daysOfWeek) {
-                if (newDay == existingDay) {
-                    commonDayFound = true;
-                    break;
-                }
-            }
-            if (commonDayFound) break;
-        }
-
-        if (commonDayFound) {
-            if (newStartTimeMinutes < existingEndTimeMinutes && newEndTimeMinutes > existingStartTimeMinutes) {
-                std::cout << "<Conflict detected with class: " << existingClass.subject
-                          << " on common day(s). Time overlap: "
-                          << existingClass.startTime << "-" << existingClass.endTime << " vs "
-                          << classToValidate.startTime << "-" << classToValidate.endTime << ".>" << std::endl;
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-void editClass() {
-    if (classSchedule.empty()) {
-        std::cout << "<No classes to edit.>" << std::endl;
-        clear_input_buffer(); // Ensure buffer is clear for potential getline later
-        std::cout << "Press Enter to return to the menu...";
-        std::string dummy;
-        std::getline(std::cin, dummy);
-        return;
-    }
-
-    std::cout << "--- Edit Class ---" << std::endl;
-    displayClassSchedule();
-
-    int choice_num;
-    while(true){
-        std::cout << "Enter the number of the class to edit (or 0 to cancel): ";
-        std::cin >> choice_num;
-        if (std::cin.good()) {
-            clear_input_buffer(); // Consume newline after number
-            break;
-        } else {
-            std::cout << "<Invalid input. Please enter a number.>" << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        }
-    }
-
-    if (choice_num == 0) {
-        std::cout << "Edit cancelled." << std::endl;
-        return;
-    }
-    if (choice_num < 1 || static_cast<size_t>(choice_num) > classSchedule.size()) {
-        std::cout << "<Invalid class number.>" << std::endl;
-        return;
-    }
-
-    size_t classIndex = static_cast<size_t>(choice_num - 1);
-    ClassDetails tempClass = classSchedule[classIndex];
-    ClassDetails originalClass = classSchedule[classIndex];
-    bool changed = false;
-    std::string input;
-
-    std::cout << "Current Subject: " << originalClass.subject << ". New (blank to keep): ";
-    std::getline(std::cin, input);
-    if (!input.empty()) { tempClass.subject = input; changed = true; }
-
-    std::cout << "Current Days: ";
-    for (size_t j = 0; j < originalClass.daysOfWeek.size(); ++j) {
-        std::cout << originalClass.daysOfWeek[j] << (j < originalClass.daysOfWeek.size() - 1 ? "," : "");
-    }
-    std::cout << ".\nNew Days (blank to keep): ";
-    std::getline(std::cin, input);
-    if (!input.empty()) {
-        std::vector<std::string> newDays;
-        if (parseDaysOfWeek(input, newDays)) { // parseDaysOfWeek from utils.h
-            if (newDays.empty() && !input.empty()){ // Successfully parsed an empty list from non-empty input.
-                 std::cout << "<No valid days recognized from your input. Days not changed.>" << std::endl;
-            } else { // newDays might be empty if input was just whitespace (which parseDaysOfWeek should handle and return true), or it might contain valid days
-                tempClass.daysOfWeek = newDays; // Allow setting to empty days list if parse was successful
-                changed = true;
-            }
-        } else {
-            // parseDaysOfWeek returned false, indicating a parsing error (e.g. invalid characters, malformed token)
-            std::cout << "<Invalid day format or unrecognized day(s) entered. Days not changed.>" << std::endl;
-        }
-    }
-
-    std::cout << "Current Start Time: " << originalClass.startTime << ". New (blank to keep): ";
-    std::getline(std::cin, input);
-    if (!input.empty()) {
-        if (isValidTimeFormat(input)) { // isValidTimeFormat from utils.h
-            tempClass.startTime = input; changed = true;
-        } else { std::cout << "<Start Time not changed due to invalid format.>" << std::endl; }
-    }
-
-    std::cout << "Current End Time: " << originalClass.endTime << ". New (blank to keep): ";
-    std::getline(std::cin, input);
-    if (!input.empty()) {
-        if (isValidTimeFormat(input)) { // isValidTimeFormat from utils.h
-            tempClass.endTime = input; changed = true;
-        } else { std::cout << "<End Time not changed due to invalid format.>" << std::endl; }
-    }
-
-    std::cout << "Current Venue: " << originalClass.venue << ". New (blank to keep): ";
-    std::getline(std::cin, input);
-    if (!input.empty()) { tempClass.venue = input; changed = true; }
-
-    if (!changed) {
-        std::cout << "<No changes were made.>" << std::endl;
-        return;
-    }
-
-    if (checkClassConflict(tempClass, static_cast<int>(classIndex))) {
-        // Error message printed by checkClassConflict
-        std::cout << "<Edit not saved due to conflict or invalid time range.>" << std::endl;
-    } else {
-        classSchedule[classIndex] = tempClass;
-        std::cout << "Class '" << tempClass.subject << "' updated successfully." << std::endl;
-        saveClassScheduleToFile(); // from file_handler.h
-    }
-}
-
-// Function to get unique subject names from the class schedule
-std::vector<std::string> get_scheduler_subjects() {
-    std::set<std::string> unique_subjects;
-    for (const auto& cls : classSchedule) { // classSchedule is global in this file
-        if (!cls.subject.empty()) {
-            unique_subjects.insert(cls.subject);
-        }
-    }
-    // Convert set to vector
-    std::vector<std::string> subjects_vector(unique_subjects.begin(), unique_subjects.end());
-    return subjects_vector;
-}
-
-void classSchedulerMenu() {
-    int choice;
-    bool running = true;
-    while (running) {
-        displayClassScheduleMenu(); // Part of scheduler_planner.cpp
-        std::cin >> choice;
-        if (std::cin.good()) {
-            clear_input_buffer(); // From utils.h, after reading number
-            switch (choice) {
-                case 1: addClass(); break;    // Part of scheduler_planner.cpp
-                case 2: editClass(); break;   // Part of scheduler_planner.cpp
-                case 3: running = false; std::cout << "Returning to Scheduler/Planner Menu..." << std::endl; break;
-                default: std::cout << "Invalid choice. Please enter a number between 1 and 3." << std::endl; break;
-            }
-        } else {
-            std::cout << "Invalid input. Please enter a number." << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        }
-    }
-}
-
-// --- Task Manager Implementation ---
-std::string urgencyToString(int urgency) {
-    switch (urgency) {
-        case 1: return "High";
-        case 2: return "Moderate";
-        case 3: return "Low";
-        default: return "Unknown";
-    }
-}
-
-void addTask() {
-    TaskDetails newTask;
-    std::cout << "--- Add New Task ---" << std::endl;
-    clear_input_buffer(); // From utils.h
-
-    std::cout << "Enter Task Name: ";
-    std::getline(std::cin, newTask.name);
-
-    if (!classSchedule.empty()) {
-        std::set<std::string> uniqueSubjects;
-        for (const auto& cls : classSchedule) { // classSchedule is global in this file
-            if(!cls.subject.empty()) uniqueSubjects.insert(cls.subject);
-        }
-
-        if (!uniqueSubjects.empty()) {
-            std::vector<std::string> subjectList(uniqueSubjects.begin(), uniqueSubjects.end());
-            std::cout << "Available Subjects from Schedule:" << std::endl;
-            for (size_t i = 0; i < subjectList.size(); ++i) {
-                std::cout << i + 1 << ". " << subjectList[i] << std::endl;
-            }
-            int otherOptionNumber = subjectList.size() + 1;
-            std::cout << otherOptionNumber << ". Other (Enter manually)" << std::endl;
-
-            int subjectChoiceNum;
-            bool subjectChosen = false;
-            while (!subjectChosen) {
-                std::cout << "Choose Subject by number (or " << otherOptionNumber << " to enter manually): ";
-                std::cin >> subjectChoiceNum;
-                if (std::cin.good()) {
-                    clear_input_buffer(); // Consume newline
-                    if (subjectChoiceNum > 0 && static_cast<size_t>(subjectChoiceNum) <= subjectList.size()) {
-                        newTask.subject = subjectList[subjectChoiceNum - 1];
-                        subjectChosen = true;
-                    } else if (subjectChoiceNum == otherOptionNumber) {
-                        std::cout << "Enter Subject: ";
-                        std::getline(std::cin, newTask.subject);
-                        subjectChosen = true;
-                    } else {
-                        std::cout << "<Invalid choice. Please try again.>" << std::endl;
-                    }
-                } else {
-                    std::cout << "<Invalid input. Please enter a number.>" << std::endl;
-                    std::cin.clear();
-                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                }
-            }
-        } else {
-             std::cout << "No subjects available from schedule. Enter Subject manually: ";
-             std::getline(std::cin, newTask.subject);
-        }
-    } else {
-        std::cout << "Enter Subject: ";
-        std::getline(std::cin, newTask.subject);
-    }
-
-    std::cout << "Enter Infos (or type 'none'): ";
-    std::getline(std::cin, newTask.infos);
-    if (newTask.infos.empty() || newTask.infos == "none") {
-        newTask.infos = "No info available";
-    }
-    std::cout << "Enter Deadline Date (YYYY-MM-DD): "; // Add date validation if desired (from utils?)
-    std::getline(std::cin, newTask.deadlineDate);
-
-    int urgencyInput;
-    while (true) {
-        std::cout << "Enter Urgency (1:High, 2:Moderate, 3:Low): ";
-        std::cin >> urgencyInput;
-        if (std::cin.good() && (urgencyInput >= 1 && urgencyInput <= 3)) {
-            newTask.urgency = urgencyInput;
-            clear_input_buffer(); // Consume newline
-            break;
-        } else {
-            std::cout << "Invalid urgency. Please enter 1, 2, or 3." << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        }
-    }
-    newTask.completed = false;
-    tasks.push_back(newTask); // tasks is global in this file
-    std::cout << "Task '" << newTask.name << "' added successfully." << std::endl;
-    saveTasksToFile(); // from file_handler.h
-}
-
-void showTasks() {
-    std::cout << "--- Show Tasks ---" << std::endl;
-    if (tasks.empty()) { // tasks is global in this file
-        std::cout << "<No tasks available>" << std::endl;
-        return;
-    }
-
-    std::vector<size_t> uncompletedTaskIndices;
-    for (size_t i = 0; i < tasks.size(); ++i) {
-        if (!tasks[i].completed) {
-            uncompletedTaskIndices.push_back(i);
-        }
-    }
-
-    if (uncompletedTaskIndices.empty()) {
-        std::cout << "<No pending tasks available>" << std::endl;
-        return;
-    }
-
-    std::sort(uncompletedTaskIndices.begin(), uncompletedTaskIndices.end(),
-        [&](size_t a, size_t b) { // Lambda captures `tasks` by reference (implicitly)
-        if (tasks[a].urgency != tasks[b].urgency) {
-            return tasks[a].urgency < tasks[b].urgency;
-        }
-        return tasks[a].deadlineDate < tasks[b].deadlineDate;
-    });
-
-    std::cout << "Pending Tasks (Sorted by Urgency, then Deadline):" << std::endl;
-    for (size_t i = 0; i < uncompletedTaskIndices.size(); ++i) {
-        const auto& task = tasks[uncompletedTaskIndices[i]];
-        std::cout << i + 1 << ". Name: " << task.name
-                  << " | Subject: " << task.subject
-                  << " | Deadline: " << task.deadlineDate
-                  << " | Urgency: " << urgencyToString(task.urgency) // urgencyToString is in this file
-                  << " | Infos: " << task.infos
-                  << std::endl;
-    }
-
-    int taskNumberToMark;
-    std::cout << "\nMark a task as completed? (Enter task number or 0 to skip): ";
-    std::cin >> taskNumberToMark;
-
-    if (std::cin.good()) { // Input was numerically valid (though maybe out of range)
-        if (taskNumberToMark > 0 && static_cast<size_t>(taskNumberToMark) <= uncompletedTaskIndices.size()) {
-            size_t actualIndexInTasksVector = uncompletedTaskIndices[taskNumberToMark - 1];
-            tasks[actualIndexInTasksVector].completed = true;
-            std::cout << "Task '" << tasks[actualIndexInTasksVector].name << "' marked as completed." << std::endl;
-            saveTasksToFile();
-        } else if (taskNumberToMark == 0) {
-            // Skipped
-        } else { // Good numeric input, but number out of logical range
-            std::cout << "<Invalid task number.>" << std::endl;
-        }
-    } else { // std::cin.good() is false - e.g., non-numeric input like "abc"
-        std::cout << "<Invalid input. Please enter a number.>" << std::endl;
-        std::cin.clear(); // Clear error flags (like failbit)
-        // The clear_input_buffer() below will now correctly consume the rest of the bad input line
-    }
-    clear_input_buffer(); // Crucial: Clears newline from good input, or the rest of the bad input line if cin was bad and is now cleared.
-}
-
-void deleteTask() {
-    if (tasks.empty()) { // tasks is global in this file
-        std::cout << "<No tasks to delete.>" << std::endl;
-        clear_input_buffer();
-        std::cout << "Press Enter to return to the menu...";
-        std::string dummy;
-        std::getline(std::cin, dummy);
-        return;
-    }
-
-    std::cout << "--- Delete Task ---" << std::endl;
-    std::cout << "Available Tasks:" << std::endl;
-    for (size_t i = 0; i < tasks.size(); ++i) {
-        const auto& task = tasks[i];
-        std::cout << i + 1 << ". Name: " << task.name
-                  << " | Subject: " << task.subject
-                  << " | Deadline: " << task.deadlineDate
-                  << " | Urgency: " << urgencyToString(task.urgency) // urgencyToString is in this file
-                  << " | Status: " << (task.completed ? "Completed" : "Pending")
-                  << std::endl;
-    }
-
-    int choice_num;
-    while (true) {
-        std::cout << "Enter the number of the task to delete (or 0 to cancel): ";
-        std::cin >> choice_num;
-        if (std::cin.good()) {
-            clear_input_buffer(); // Consume newline
-            if (choice_num >= 0 && static_cast<size_t>(choice_num) <= tasks.size()) {
-                break;
-            } else {
-                std::cout << "<Invalid task number. Please try again.>" << std::endl;
-            }
-        } else {
-            std::cout << "<Invalid input. Please enter a number.>" << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        }
-    }
-
-    if (choice_num == 0) {
-        std::cout << "Deletion cancelled." << std::endl;
-        return;
-    }
-
-    size_t taskIndex = static_cast<size_t>(choice_num - 1);
-    TaskDetails taskToDelete = tasks[taskIndex];
-
-    std::string confirmStr;
-    while(true) {
-        std::cout << "Are you sure you want to delete task '" << taskToDelete.name << "'? (yes/no): ";
-        std::getline(std::cin, confirmStr); // std::cin was cleared by clear_input_buffer
-        std::transform(confirmStr.begin(), confirmStr.end(), confirmStr.begin(), ::tolower);
-        if (confirmStr == "yes" || confirmStr == "y" || confirmStr == "no" || confirmStr == "n") {
-            break;
-        }
-        std::cout << "<Invalid input. Please type 'yes' or 'no'.>" << std::endl;
-    }
-
-    if (confirmStr == "yes" || confirmStr == "y") {
-        tasks.erase(tasks.begin() + taskIndex);
-        std::cout << "Task '" << taskToDelete.name << "' deleted successfully." << std::endl;
-        saveTasksToFile(); // from file_handler.h
-    } else {
-        std::cout << "Deletion cancelled." << std::endl;
-    }
-}
-
-void taskManagerMenu() {
-    int choice;
-    bool running = true;
-    while (running) {
-        displayTaskManagerMenu(); // Part of scheduler_planner.cpp
-        std::cin >> choice;
-        if (std::cin.good()) {
-            clear_input_buffer(); // From utils.h
-            switch (choice) {
-                case 1: showTasks(); break;   // Part of scheduler_planner.cpp
-                case 2: addTask(); break;     // Part of scheduler_planner.cpp
-                case 3: deleteTask(); break;  // Part of scheduler_planner.cpp
-                case 4: running = false; std::cout << "Returning to Scheduler/Planner Menu..." << std::endl; break;
-                default: std::cout << "Invalid choice. Please enter a number between 1 and 4." << std::endl; break;
-            }
-        } else {
-            std::cout << "Invalid input. Please enter a number." << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        }
-    }
-}
-
-// This is the top-level menu for this module
-void schedulerPlannerMenu() {
-    int choice;
-    bool running = true;
-    while (running) {
-        displaySchedulerPlannerMenu(); // Part of scheduler_planner.cpp
-        std::cin >> choice;
-        if (std::cin.good()) {
-            clear_input_buffer(); // From utils.h
-            switch (choice) {
-                case 1: displayCalendar(); break;    // Part of scheduler_planner.cpp
-                case 2: classSchedulerMenu(); break; // Part of scheduler_planner.cpp
-                case 3: taskManagerMenu(); break;    // Part of scheduler_planner.cpp
-                case 4: running = false; std::cout << "Returning to Main Menu..." << std::endl; break;
-                default: std::cout << "Invalid choice. Please enter a number between 1 and 4." << std::endl; break;
-            }
-        } else {
-            std::cout << "Invalid input. Please enter a number." << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-        }
-    }
-}
+#include "scheduler_planner.h"
+#include "utils.h"        // For various utility functions
+#include "console_input.h" // For clear_input_buffer
+#include "file_handler.h" // For saving/loading schedule and tasks
+#include "startup_loader.h" // For ensureScheduleLoaded, ensureTasksLoaded
+#include "subject_registry.h" // For subject_registry
+#include "term_calendar.h"  // For termCalendar, ClassOccurrenceCursor
+#include "timetable_solver.h" // For solveTimetable, readSectionCandidatesCsv
+#include <algorithm>      // For std::sort, std::transform
+#include <limits>         // For std::numeric_limits
+#include <sstream>        // For std::stringstream in addClass (day parsing, though primary parsing is in utils)
+#include <iomanip>        // For std::put_time (though this is now in utils.cpp) - remove if not directly used
+
+// --- Calendar Implementation ---
+void displayCalendar() {
+    CivilDate today = CivilDate::today();
+    std::string current_day_of_week = getCurrentDayOfWeek();
+
+    std::cout << "\n--- Calendar ---" << std::endl;
+    std::cout << "Today's Date: " << today << " (" << current_day_of_week << ")" << std::endl;
+
+    std::cout << "\n--- Today's Classes (" << current_day_of_week << ") ---" << std::endl;
+    const TermHoliday* holiday = termCalendar.holidayOn(today);
+    if (holiday) {
+        std::cout << "<Holiday: " << holiday->name << ">" << std::endl;
+    } else if (const TermMakeUpDay* makeUp = termCalendar.makeUpDayOn(today)) {
+        std::cout << "<Make-up day: " << dayIndexToName(makeUp->followsWeekday) << " classes meet today>" << std::endl;
+    }
+    bool found_class_today = false;
+    int class_display_count = 1;
+    ClassOccurrenceCursor occurrences(termCalendar, classConflictIndex, today, today);
+    ClassOccurrence occurrence;
+    while (occurrences.next(occurrence)) {
+        const ClassDetails& cls = classSchedule[occurrence.classIndex];
+        found_class_today = true;
+        std::cout << class_display_count++ << ". Subject: " << cls.subject
+                  << ", Start: " << minutesToTimeString(cls.startMinutes)
+                  << ", End: " << minutesToTimeString(cls.endMinutes)
+                  << ", Venue: " << cls.venue << std::endl;
+    }
+    if (!found_class_today) {
+        std::cout << (termCalendar.inTerm(today) ? "<No classes scheduled for today>" : "<No classes: today is outside the term>") << std::endl;
+    }
+
+    std::cout << "\n--- Today's Tasks (Due Today or Overdue and Not Completed) ---" << std::endl;
+    bool found_task_for_today = false;
+    int task_display_count = 1;
+    std::vector<size_t> due_task_indices = taskPriorityIndex.pendingDueBy(today);
+    for (size_t k = 0; k < due_task_indices.size(); ++k) {
+        const auto& task = tasks[due_task_indices[k]];
+        if (!found_task_for_today) found_task_for_today = true;
+        std::cout << task_display_count++ << ". Name: " << task.name
+                  << " | Subject: " << task.subject
+                  << " | Deadline: " << task.deadline
+                  << " | Urgency: " << urgencyToString(task.urgency)
+                  << " | Infos: " << task.infos
+                  << std::endl;
+    }
+    if (!found_task_for_today) {
+        std::cout << "<No tasks due today or overdue>" << std::endl;
+    }
+
+    std::cout << "\nPress Enter to return to the menu...";
+    clear_input_buffer(); // From utils.h
+    // Wait for a new line
+    std::string dummy;
+    std::getline(std::cin, dummy);
+}
+
+// Reads a line until it is a valid YYYY-MM-DD date.
+static CivilDate promptForDate(const std::string& prompt) {
+    std::string input;
+    while (true) {
+        std::cout << prompt;
+        std::getline(std::cin, input);
+        CivilDate date = CivilDate::parse(input);
+        if (date.isValid()) return date;
+        std::cout << "<Invalid date. Please use YYYY-MM-DD, e.g. " << CivilDate::today() << ".>" << std::endl;
+    }
+}
+
+// Prints every day in [first, last] with its classes and the pending tasks due
+// on it. Classes come from ClassOccurrenceCursor and tasks from one range
+// lookup in the deadline index, both already in date order, so the two are
+// merged in a single pass: the work is proportional to the range shown, not
+// to the length of the term. Empty days are skipped unless showEmptyDays.
+static void displayAgenda(CivilDate first, CivilDate last, bool showEmptyDays) {
+    ClassOccurrenceCursor occurrences(termCalendar, classConflictIndex, first, last);
+    ClassOccurrence occurrence;
+    bool haveOccurrence = occurrences.next(occurrence);
+    std::vector<size_t> due = taskPriorityIndex.pendingDueBetween(first, last);
+    size_t nextDue = 0;
+    bool printedAnything = false;
+
+    for (CivilDate day = first; day <= last; day = day.plusDays(1)) {
+        const TermHoliday* holiday = termCalendar.holidayOn(day);
+        const TermMakeUpDay* makeUp = termCalendar.makeUpDayOn(day);
+        bool hasEntries = (haveOccurrence && occurrence.date == day) ||
+                          (nextDue < due.size() && tasks[due[nextDue]].deadline == day);
+        if (!hasEntries && !showEmptyDays && !holiday && !makeUp) continue;
+
+        printedAnything = true;
+        std::cout << "\n" << dayIndexToName(day.weekday()) << " " << day;
+        if (holiday) {
+            std::cout << "  [Holiday: " << holiday->name << "]";
+        } else if (!termCalendar.inTerm(day)) {
+            std::cout << "  [Outside term]";
+        } else if (makeUp) {
+            std::cout << "  [Make-up day: " << dayIndexToName(makeUp->followsWeekday) << " classes]";
+        }
+        std::cout << std::endl;
+
+        for (; haveOccurrence && occurrence.date == day; haveOccurrence = occurrences.next(occurrence)) {
+            const ClassDetails& cls = classSchedule[occurrence.classIndex];
+            std::cout << "  " << minutesToTimeString(occurrence.startMinutes)
+                      << "-" << minutesToTimeString(occurrence.endMinutes)
+                      << "  " << cls.subject << " @ " << cls.venue << std::endl;
+        }
+        for (; nextDue < due.size() && tasks[due[nextDue]].deadline == day; ++nextDue) {
+            const auto& task = tasks[due[nextDue]];
+            std::cout << "  Due: " << task.name << " (" << task.subject
+                      << ", " << urgencyToString(task.urgency) << ")" << std::endl;
+        }
+        if (!hasEntries && showEmptyDays && !holiday) {
+            std::cout << "  <Nothing scheduled>" << std::endl;
+        }
+    }
+    if (!printedAnything) {
+        std::cout << "<Nothing scheduled>" << std::endl;
+    }
+}
+
+// Reads a date, or returns today for a blank line.
+static CivilDate promptForDateOrToday(const std::string& prompt) {
+    std::string input;
+    while (true) {
+        std::cout << prompt;
+        std::getline(std::cin, input);
+        if (input.empty()) return CivilDate::today();
+        CivilDate date = CivilDate::parse(input);
+        if (date.isValid()) return date;
+        std::cout << "<Invalid date. Please use YYYY-MM-DD, e.g. " << CivilDate::today() << ".>" << std::endl;
+    }
+}
+
+void displayWeekAgenda() {
+    CivilDate monday = promptForDateOrToday("Enter a date in the week (YYYY-MM-DD, blank for this week): ").weekStart();
+    std::cout << "\n--- Week of " << monday << " ---" << std::endl;
+    displayAgenda(monday, monday.plusDays(6), true);
+    std::cout << "\nPress Enter to return to the menu...";
+    std::string dummy;
+    std::getline(std::cin, dummy);
+}
+
+void displayMonthAgenda() {
+    CivilDate inMonth = promptForDateOrToday("Enter a date in the month (YYYY-MM-DD, blank for this month): ");
+    int year, month, day;
+    inMonth.toYmd(year, month, day);
+    CivilDate first = CivilDate::fromYmd(year, month, 1);
+    CivilDate nextFirst = month == 12 ? CivilDate::fromYmd(year + 1, 1, 1) : CivilDate::fromYmd(year, month + 1, 1);
+    CivilDate last = nextFirst.isValid() ? nextFirst.plusDays(-1) : first.plusDays(30); // December 9999
+    std::cout << "\n--- " << first << " to " << last << " ---" << std::endl;
+    displayAgenda(first, last, false);
+    std::cout << "\nPress Enter to return to the menu...";
+    std::string dummy;
+    std::getline(std::cin, dummy);
+}
+
+static void displayTermSettings() {
+    std::cout << "\nTerm: ";
+    if (!termCalendar.firstDay.isValid() && !termCalendar.lastDay.isValid()) {
+        std::cout << "<Not set: classes repeat every week>" << std::endl;
+    } else {
+        std::cout << termCalendar.firstDay << " to " << termCalendar.lastDay << std::endl;
+    }
+    std::cout << "Holidays:" << std::endl;
+    if (termCalendar.holidays.empty()) std::cout << "  <None>" << std::endl;
+    for (const auto& holiday : termCalendar.holidays) {
+        std::cout << "  " << holiday.date << "  " << holiday.name << std::endl;
+    }
+    std::cout << "Make-up days:" << std::endl;
+    if (termCalendar.makeUpDays.empty()) std::cout << "  <None>" << std::endl;
+    for (const auto& makeUp : termCalendar.makeUpDays) {
+        std::cout << "  " << makeUp.date << "  follows " << dayIndexToName(makeUp.followsWeekday) << std::endl;
+    }
+}
+
+void termSettingsMenu() {
+    int choice;
+    bool running = true;
+    while (running) {
+        displayTermSettings();
+        std::cout << "\n--- Term Settings ---" << std::endl;
+        std::cout << "1. Set Term Dates" << std::endl;
+        std::cout << "2. Add Holiday" << std::endl;
+        std::cout << "3. Remove Holiday" << std::endl;
+        std::cout << "4. Add Make-Up Day" << std::endl;
+        std::cout << "5. Remove Make-Up Day" << std::endl;
+        std::cout << "6. Back to Calendar Menu" << std::endl;
+        std::cout << "Enter your choice (1-6): ";
+        std::cin >> choice;
+        if (!std::cin.good()) {
+            std::cout << "Invalid input. Please enter a number." << std::endl;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            continue;
+        }
+        clear_input_buffer();
+        bool changed = false;
+        switch (choice) {
+            case 1: {
+                CivilDate first = promptForDate("Enter first day of term (YYYY-MM-DD): ");
+                CivilDate last = promptForDate("Enter last day of term (YYYY-MM-DD): ");
+                if (last < first) std::swap(first, last);
+                termCalendar.firstDay = first;
+                termCalendar.lastDay = last;
+                changed = true;
+                break;
+            }
+            case 2: {
+                CivilDate day = promptForDate("Enter holiday date (YYYY-MM-DD): ");
+                std::string name = get_string_input("Enter holiday name: ");
+                termCalendar.setHoliday(day, name.empty() ? "Holiday" : name);
+                changed = true;
+                break;
+            }
+            case 3:
+                changed = termCalendar.removeHoliday(promptForDate("Enter holiday date to remove (YYYY-MM-DD): "));
+                if (!changed) std::cout << "<No holiday on that date.>" << std::endl;
+                break;
+            case 4: {
+                CivilDate day = promptForDate("Enter make-up day date (YYYY-MM-DD): ");
+                std::string weekdayInput = get_string_input("Which weekday's classes meet that day (e.g. Mon): ");
+                int weekday = dayTokenToIndex(weekdayInput.data(), weekdayInput.size());
+                if (weekday == -1) {
+                    std::cout << "<Unknown weekday.>" << std::endl;
+                    break;
+                }
+                termCalendar.setMakeUpDay(day, weekday);
+                changed = true;
+                break;
+            }
+            case 5:
+                changed = termCalendar.removeMakeUpDay(promptForDate("Enter make-up day date to remove (YYYY-MM-DD): "));
+                if (!changed) std::cout << "<No make-up day on that date.>" << std::endl;
+                break;
+            case 6: running = false; std::cout << "Returning to Calendar Menu..." << std::endl; break;
+            default: std::cout << "Invalid choice. Please enter a number between 1 and 6." << std::endl; break;
+        }
+        if (changed) {
+            saveTermCalendarToFile(); // from file_handler.h
+            std::cout << "Term calendar saved." << std::endl;
+        }
+    }
+}
+
+void displayCalendarMenu() {
+    std::cout << "\nISKAALAMAN Calendar Menu:" << std::endl;
+    std::cout << "1. Today" << std::endl;
+    std::cout << "2. Week Agenda" << std::endl;
+    std::cout << "3. Month Agenda" << std::endl;
+    std::cout << "4. Term Settings" << std::endl;
+    std::cout << "5. Back to Scheduler/Planner Menu" << std::endl;
+    std::cout << "Enter your choice (1-5): ";
+}
+
+void calendarMenu() {
+    int choice;
+    bool running = true;
+    while (running) {
+        displayCalendarMenu(); // Part of scheduler_planner.cpp
+        std::cin >> choice;
+        if (std::cin.good()) {
+            clear_input_buffer(); // From utils.h
+            switch (choice) {
+                case 1: displayCalendar(); break;    // Part of scheduler_planner.cpp
+                case 2: displayWeekAgenda(); break;  // Part of scheduler_planner.cpp
+                case 3: displayMonthAgenda(); break; // Part of scheduler_planner.cpp
+                case 4: termSettingsMenu(); break;   // Part of scheduler_planner.cpp
+                case 5: running = false; std::cout << "Returning to Scheduler/Planner Menu..." << std::endl; break;
+                default: std::cout << "Invalid choice. Please enter a number between 1 and 5." << std::endl; break;
+            }
+        } else {
+            std::cout << "Invalid input. Please enter a number." << std::endl;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+}
+
+// --- Menu Display Functions for Scheduler/Planner ---
+void displaySchedulerPlannerMenu() {
+    std::cout << "\nISKAALAMAN Scheduler and Planner Menu:" << std::endl;
+    std::cout << "1. Calendar" << std::endl;
+    std::cout << "2. Class Scheduler" << std::endl;
+    std::cout << "3. Task Manager" << std::endl;
+    std::cout << "4. Back to Main Menu" << std::endl;
+    std::cout << "Enter your choice (1-4): ";
+}
+
+void displayClassScheduleMenu() {
+    std::cout << "\n--- Class Schedule ---" << std::endl;
+    displayClassSchedule(); // Assumes this is now part of scheduler_planner.cpp
+    std::cout << "\nClass Scheduler Options:" << std::endl;
+    std::cout << "1. Add Class" << std::endl;
+    std::cout << "2. Edit Class" << std::endl;
+    std::cout << "3. Plan Sections from CSV" << std::endl;
+    std::cout << "4. Back to Scheduler/Planner Menu" << std::endl;
+    std::cout << "Enter your choice (1-4): ";
+}
+
+void displayTaskManagerMenu() {
+    std::cout << "\n--- Task Manager ---" << std::endl;
+    std::cout << "1. Show Tasks" << std::endl;
+    std::cout << "2. Add Task" << std::endl;
+    std::cout << "3. Delete Task" << std::endl;
+    std::cout << "4. Tasks by Due Date" << std::endl;
+    std::cout << "5. Back to Scheduler/Planner Menu" << std::endl;
+    std::cout << "Enter your choice (1-5): ";
+}
+
+// --- Class Scheduler Implementation ---
+void displayClassSchedule() {
+    if (classSchedule.empty()) {
+        std::cout << "<no class schedule is available>" << std::endl;
+    } else {
+        std::cout << "Current Class Schedule:" << std::endl;
+        for (size_t i = 0; i < classSchedule.size(); ++i) {
+            std::cout << i + 1 << ". Subject: " << classSchedule[i].subject << ", Days: ";
+            if (classSchedule[i].dayMask == 0) {
+                std::cout << "N/A";
+            } else {
+                std::cout << dayMaskToString(classSchedule[i].dayMask);
+            }
+            std::cout << ", Start: " << minutesToTimeString(classSchedule[i].startMinutes)
+                      << ", End: " << minutesToTimeString(classSchedule[i].endMinutes)
+                      << ", Venue: " << classSchedule[i].venue << std::endl;
+        }
+    }
+}
+
+void addClass() {
+    ClassDetails newClass;
+    std::cout << "--- Add New Class ---" << std::endl;
+    clear_input_buffer(); // From utils.h
+
+    std::cout << "Enter Subject: ";
+    std::getline(std::cin, newClass.subject);
+
+    std::string timeInput;
+    while(true) {
+        std::cout << "Enter Start Time (e.g., 09:00 AM): ";
+        std::getline(std::cin, timeInput);
+        newClass.startMinutes = timeToMinutes(timeInput); // from utils.h
+        if (newClass.startMinutes != -1) break;
+        std::cout << "<Invalid time format. Please use HH:MM AM/PM (e.g., 09:30 AM).>" << std::endl;
+    }
+
+    while(true) {
+        std::cout << "Enter End Time (e.g., 10:00 AM): ";
+        std::getline(std::cin, timeInput);
+        newClass.endMinutes = timeToMinutes(timeInput); // from utils.h
+        if (newClass.endMinutes != -1) break;
+        std::cout << "<Invalid time format. Please use HH:MM AM/PM (e.g., 09:30 AM).>" << std::endl;
+    }
+
+    bool daysParsedSuccessfully = false;
+    std::string daysInput;
+    while(!daysParsedSuccessfully){
+        std::cout << "Enter Days of Week (e.g., Mon,Wed,Fri or M,T,W,TH,F,Sat,Sun): ";
+        std::getline(std::cin, daysInput);
+        if (daysInput.empty()){
+            std::cout << "<Days of week cannot be empty when adding a new class.>" << std::endl;
+            continue;
+        }
+        if (parseDaysOfWeek(daysInput, newClass.dayMask)) { // parseDaysOfWeek from utils.h
+            if (newClass.dayMask == 0 && !daysInput.empty()) {
+                std::cout << "<No valid days were recognized. Please check format (e.g., Mon,Tue,Wed).>" << std::endl;
+            } else if (newClass.dayMask == 0 && daysInput.empty()) {
+                // This case should ideally not be hit if daysInput.empty() is checked above.
+                // However, if parseDaysOfWeek can somehow result in an empty mask for an empty daysInput (e.g. only whitespace)
+                // and still return true, this could be a fallback.
+                // For addClass, empty days are an error.
+                std::cout << "<No days entered. Please enter days for the class.>" << std::endl;
+            }
+            else { // Valid days parsed and dayMask is not empty
+                daysParsedSuccessfully = true;
+            }
+        } else {
+            std::cout << "<Invalid day format or unrecognized day(s) entered. Please use formats like Mon,Tue,Wed or M,T,W,TH,F,Sat,Sun.>" << std::endl;
+        }
+    }
+
+    std::cout << "Enter Venue: ";
+    std::getline(std::cin, newClass.venue);
+
+    if (checkClassConflict(newClass, -1)) { // checkClassConflict is now part of scheduler_planner.cpp
+        // Error message printed by checkClassConflict
+    } else {
+        appendClass(newClass); // From scheduler_core.h
+        std::cout << "Class '" << newClass.subject << "' added successfully." << std::endl;
+        journalClassAdded(newClass); // from file_handler.h
+    }
+}
+
+bool checkClassConflict(const ClassDetails& classToValidate, int editingClassIndex) {
+    int newStartTimeMinutes = classToValidate.startMinutes;
+    int newEndTimeMinutes = classToValidate.endMinutes;
+
+    if (newStartTimeMinutes == -1 || newEndTimeMinutes == -1) {
+        // This implies an invalid format that wasn't caught by initial input validation,
+        // or data was corrupted. Times are parsed by timeToMinutes at input/load time.
+        std::cout << "<Internal Error: Invalid time format in class being validated. Conflict check aborted.>" << std::endl;
+        return true; // Treat as conflict to be safe
+    }
+
+    if (newStartTimeMinutes >= newEndTimeMinutes) {
+        std::cout << "<Start time must be before end time. Class not added/updated.>" << std::endl;
+        return true;
+    }
+
+    std::vector<size_t> conflicts = classConflictIndex.findConflicts(classToValidate, editingClassIndex);
+    for (size_t i = 0; i < conflicts.size(); ++i) {
+        const auto& existingClass = classSchedule[conflicts[i]];
+        std::cout << "<Conflict detected with class: " << existingClass.subject
+                  << " on common day(s). Time overlap: "
+                  << minutesToTimeString(existingClass.startMinutes) << "-" << minutesToTimeString(existingClass.endMinutes) << " vs "
+                  << minutesToTimeString(newStartTimeMinutes) << "-" << minutesToTimeString(newEndTimeMinutes) << ".>" << std::endl;
+    }
+    return !conflicts.empty();
+}
+
+void editClass() {
+    if (classSchedule.empty()) {
+        std::cout << "<No classes to edit.>" << std::endl;
+        clear_input_buffer(); // Ensure buffer is clear for potential getline later
+        std::cout << "Press Enter to return to the menu...";
+        std::string dummy;
+        std::getline(std::cin, dummy);
+        return;
+    }
+
+    std::cout << "--- Edit Class ---" << std::endl;
+    displayClassSchedule();
+
+    int choice_num;
+    while(true){
+        std::cout << "Enter the number of the class to edit (or 0 to cancel): ";
+        std::cin >> choice_num;
+        if (std::cin.good()) {
+            clear_input_buffer(); // Consume newline after number
+            break;
+        } else {
+            std::cout << "<Invalid input. Please enter a number.>" << std::endl;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+
+    if (choice_num == 0) {
+        std::cout << "Edit cancelled." << std::endl;
+        return;
+    }
+    if (choice_num < 1 || static_cast<size_t>(choice_num) > classSchedule.size()) {
+        std::cout << "<Invalid class number.>" << std::endl;
+        return;
+    }
+
+    size_t classIndex = static_cast<size_t>(choice_num - 1);
+    ClassDetails tempClass = classSchedule[classIndex];
+    ClassDetails originalClass = classSchedule[classIndex];
+    bool changed = false;
+    std::string input;
+
+    std::cout << "Current Subject: " << originalClass.subject << ". New (blank to keep): ";
+    std::getline(std::cin, input);
+    if (!input.empty()) { tempClass.subject = input; changed = true; }
+
+    std::cout << "Current Days: " << dayMaskToString(originalClass.dayMask);
+    std::cout << ".\nNew Days (blank to keep): ";
+    std::getline(std::cin, input);
+    if (!input.empty()) {
+        unsigned char newDays = 0;
+        if (parseDaysOfWeek(input, newDays)) { // parseDaysOfWeek from utils.h
+            if (newDays == 0 && !input.empty()){ // Successfully parsed an empty mask from non-empty input.
+                 std::cout << "<No valid days recognized from your input. Days not changed.>" << std::endl;
+            } else { // newDays holds the valid days that were entered
+                tempClass.dayMask = newDays;
+                changed = true;
+            }
+        } else {
+            // parseDaysOfWeek returned false, indicating a parsing error (e.g. invalid characters, malformed token)
+            std::cout << "<Invalid day format or unrecognized day(s) entered. Days not changed.>" << std::endl;
+        }
+    }
+
+    std::cout << "Current Start Time: " << minutesToTimeString(originalClass.startMinutes) << ". New (blank to keep): ";
+    std::getline(std::cin, input);
+    if (!input.empty()) {
+        int minutes = timeToMinutes(input); // from utils.h
+        if (minutes != -1) {
+            tempClass.startMinutes = minutes; changed = true;
+        } else { std::cout << "<Start Time not changed due to invalid format.>" << std::endl; }
+    }
+
+    std::cout << "Current End Time: " << minutesToTimeString(originalClass.endMinutes) << ". New (blank to keep): ";
+    std::getline(std::cin, input);
+    if (!input.empty()) {
+        int minutes = timeToMinutes(input); // from utils.h
+        if (minutes != -1) {
+            tempClass.endMinutes = minutes; changed = true;
+        } else { std::cout << "<End Time not changed due to invalid format.>" << std::endl; }
+    }
+
+    std::cout << "Current Venue: " << originalClass.venue << ". New (blank to keep): ";
+    std::getline(std::cin, input);
+    if (!input.empty()) { tempClass.venue = input; changed = true; }
+
+    if (!changed) {
+        std::cout << "<No changes were made.>" << std::endl;
+        return;
+    }
+
+    if (checkClassConflict(tempClass, static_cast<int>(classIndex))) {
+        // Error message printed by checkClassConflict
+        std::cout << "<Edit not saved due to conflict or invalid time range.>" << std::endl;
+    } else {
+        classConflictIndex.erase(classIndex, classSchedule[classIndex]);
+        subject_registry.remove_class(classIndex, classSchedule[classIndex].subject);
+        classSchedule[classIndex] = tempClass;
+        classConflictIndex.insert(classIndex, tempClass);
+        subject_registry.add_class(classIndex, tempClass.subject);
+        std::cout << "Class '" << tempClass.subject << "' updated successfully." << std::endl;
+        journalClassEdited(classIndex, tempClass); // from file_handler.h
+    }
+}
+
+void printTimetableSolution(size_t rank, const std::vector<TimetableSubject>& subjects, const TimetableSolution& solution) {
+    std::cout << "#" << rank << "  Penalty " << solution.penalty
+              << " (early " << solution.earlyMinutes << " min, idle " << solution.idleMinutes
+              << " min, " << solution.days << " day(s))" << std::endl;
+    for (size_t i = 0; i < subjects.size(); ++i) {
+        const ClassDetails& section = subjects[i].sections[solution.sections[i]];
+        std::cout << "    " << section.subject << ": " << dayMaskToString(section.dayMask)
+                  << " " << minutesToTimeString(section.startMinutes)
+                  << "-" << minutesToTimeString(section.endMinutes)
+                  << ", Venue: " << section.venue << std::endl;
+    }
+}
+
+void planSections() {
+    std::cout << "--- Plan Sections ---" << std::endl;
+    std::cout << "Each CSV row is one section: subject,days,start,end[,venue]. Rows with the same subject are alternatives." << std::endl;
+    std::string path = get_string_input("Enter CSV file path: ");
+    std::vector<TimetableSubject> subjects;
+    std::vector<ClassImportIssue> issues;
+    if (!readSectionCandidatesCsv(path, subjects, issues)) { // From timetable_solver.h
+        std::cout << "<Could not read " << path << ".>" << std::endl;
+        return;
+    }
+    for (size_t i = 0; i < issues.size(); ++i) {
+        std::cout << "<Line " << issues[i].line << " skipped: " << issues[i].message << ">" << std::endl;
+    }
+    if (subjects.empty()) {
+        std::cout << "<No sections to plan.>" << std::endl;
+        return;
+    }
+
+    TimetablePreferences preferences;
+    preferences.maxResults = 5;
+    while (true) {
+        std::string input = get_string_input("Avoid classes before (e.g., 09:00 AM; blank for 09:00 AM): ");
+        if (input.empty()) break;
+        int minutes = timeToMinutes(input);
+        if (minutes != -1) {
+            preferences.earliestStartMinutes = minutes;
+            break;
+        }
+        std::cout << "<Invalid time format. Please use HH:MM AM/PM (e.g., 09:30 AM).>" << std::endl;
+    }
+
+    // Classes already in the schedule stay put; the sections are fitted around them
+    std::vector<TimetableSolution> solutions = solveTimetable(subjects, classSchedule, preferences);
+    if (solutions.empty()) {
+        std::cout << "<No combination of these sections fits without a conflict.>" << std::endl;
+        return;
+    }
+    std::cout << "\nBest combinations (lower penalty is better):" << std::endl;
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        printTimetableSolution(i + 1, subjects, solutions[i]);
+    }
+
+    int choice;
+    while (true) {
+        std::cout << "Add which combination to your schedule? (1-" << solutions.size() << ", 0 for none): ";
+        std::cin >> choice;
+        if (std::cin.good() && choice >= 0 && choice <= static_cast<int>(solutions.size())) {
+            clear_input_buffer();
+            break;
+        }
+        std::cout << "<Invalid choice.>" << std::endl;
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    if (choice == 0) {
+        std::cout << "No classes added." << std::endl;
+        return;
+    }
+    const TimetableSolution& chosen = solutions[choice - 1];
+    for (size_t i = 0; i < subjects.size(); ++i) {
+        const ClassDetails& section = subjects[i].sections[chosen.sections[i]];
+        appendClass(section); // From scheduler_core.h
+        journalClassAdded(section); // from file_handler.h
+    }
+    std::cout << subjects.size() << " class(es) added." << std::endl;
+}
+
+void classSchedulerMenu() {
+    int choice;
+    bool running = true;
+    while (running) {
+        displayClassScheduleMenu(); // Part of scheduler_planner.cpp
+        std::cin >> choice;
+        if (std::cin.good()) {
+            clear_input_buffer(); // From utils.h, after reading number
+            switch (choice) {
+                case 1: addClass(); break;    // Part of scheduler_planner.cpp
+                case 2: editClass(); break;   // Part of scheduler_planner.cpp
+                case 3: planSections(); break; // Part of scheduler_planner.cpp
+                case 4: running = false; std::cout << "Returning to Scheduler/Planner Menu..." << std::endl; break;
+                default: std::cout << "Invalid choice. Please enter a number between 1 and 4." << std::endl; break;
+            }
+        } else {
+            std::cout << "Invalid input. Please enter a number." << std::endl;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+}
+
+// --- Task Manager Implementation ---
+void addTask() {
+    TaskDetails newTask;
+    std::cout << "--- Add New Task ---" << std::endl;
+    clear_input_buffer(); // From utils.h
+
+    std::cout << "Enter Task Name: ";
+    std::string nameInput;
+    std::getline(std::cin, nameInput);
+
+    if (!classSchedule.empty()) {
+        const std::vector<std::string>& subjectList = get_scheduler_subjects();
+
+        if (!subjectList.empty()) {
+            std::cout << "Available Subjects from Schedule:" << std::endl;
+            for (size_t i = 0; i < subjectList.size(); ++i) {
+                std::cout << i + 1 << ". " << subjectList[i] << std::endl;
+            }
+            int otherOptionNumber = subjectList.size() + 1;
+            std::cout << otherOptionNumber << ". Other (Enter manually)" << std::endl;
+
+            int subjectChoiceNum;
+            bool subjectChosen = false;
+            while (!subjectChosen) {
+                std::cout << "Choose Subject by number (or " << otherOptionNumber << " to enter manually): ";
+                std::cin >> subjectChoiceNum;
+                if (std::cin.good()) {
+                    clear_input_buffer(); // Consume newline
+                    if (subjectChoiceNum > 0 && static_cast<size_t>(subjectChoiceNum) <= subjectList.size()) {
+                        newTask.subject = subjectList[subjectChoiceNum - 1];
+                        subjectChosen = true;
+                    } else if (subjectChoiceNum == otherOptionNumber) {
+                        std::cout << "Enter Subject: ";
+                        std::getline(std::cin, newTask.subject);
+                        subjectChosen = true;
+                    } else {
+                        std::cout << "<Invalid choice. Please try again.>" << std::endl;
+                    }
+                } else {
+                    std::cout << "<Invalid input. Please enter a number.>" << std::endl;
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                }
+            }
+        } else {
+             std::cout << "No subjects available from schedule. Enter Subject manually: ";
+             std::getline(std::cin, newTask.subject);
+        }
+    } else {
+        std::cout << "Enter Subject: ";
+        std::getline(std::cin, newTask.subject);
+    }
+
+    std::cout << "Enter Infos (or type 'none'): ";
+    std::string infosInput;
+    std::getline(std::cin, infosInput);
+    if (infosInput.empty() || infosInput == "none") {
+        infosInput = "No info available";
+    }
+    newTask.deadline = promptForDate("Enter Deadline Date (YYYY-MM-DD): ");
+
+    int urgencyInput;
+    while (true) {
+        std::cout << "Enter Urgency (1:High, 2:Moderate, 3:Low): ";
+        std::cin >> urgencyInput;
+        if (std::cin.good() && (urgencyInput >= 1 && urgencyInput <= 3)) {
+            newTask.urgency = urgencyInput;
+            clear_input_buffer(); // Consume newline
+            break;
+        } else {
+            std::cout << "Invalid urgency. Please enter 1, 2, or 3." << std::endl;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+    newTask.completed = false;
+    newTask.name = tasksArena.copy(nameInput);
+    newTask.infos = tasksArena.copy(infosInput);
+    appendTask(newTask); // tasks is global in this file
+    std::cout << "Task '" << newTask.name << "' added successfully." << std::endl;
+    journalTaskAdded(newTask); // from file_handler.h
+}
+
+void showTasks() {
+    std::cout << "--- Show Tasks ---" << std::endl;
+    if (taskCount() == 0) {
+        std::cout << "<No tasks available>" << std::endl;
+        return;
+    }
+
+    // Already ordered by urgency, then deadline
+    std::vector<size_t> uncompletedTaskIndices = taskPriorityIndex.pendingByPriority();
+
+    if (uncompletedTaskIndices.empty()) {
+        std::cout << "<No pending tasks available>" << std::endl;
+        return;
+    }
+
+    std::cout << "Pending Tasks (Sorted by Urgency, then Deadline):" << std::endl;
+    for (size_t i = 0; i < uncompletedTaskIndices.size(); ++i) {
+        const auto& task = tasks[uncompletedTaskIndices[i]];
+        std::cout << i + 1 << ". Name: " << task.name
+                  << " | Subject: " << task.subject
+                  << " | Deadline: " << task.deadline
+                  << " | Urgency: " << urgencyToString(task.urgency) // urgencyToString is in this file
+                  << " | Infos: " << task.infos
+                  << std::endl;
+    }
+
+    int taskNumberToMark;
+    std::cout << "\nMark a task as completed? (Enter task number or 0 to skip): ";
+    std::cin >> taskNumberToMark;
+
+    if (std::cin.good()) { // Input was numerically valid (though maybe out of range)
+        if (taskNumberToMark > 0 && static_cast<size_t>(taskNumberToMark) <= uncompletedTaskIndices.size()) {
+            size_t actualIndexInTasksVector = uncompletedTaskIndices[taskNumberToMark - 1];
+            completeTaskAt(actualIndexInTasksVector);
+            std::cout << "Task '" << tasks[actualIndexInTasksVector].name << "' marked as completed." << std::endl;
+            journalTaskCompleted(actualIndexInTasksVector);
+        } else if (taskNumberToMark == 0) {
+            // Skipped
+        } else { // Good numeric input, but number out of logical range
+            std::cout << "<Invalid task number.>" << std::endl;
+        }
+    } else { // std::cin.good() is false - e.g., non-numeric input like "abc"
+        std::cout << "<Invalid input. Please enter a number.>" << std::endl;
+        std::cin.clear(); // Clear error flags (like failbit)
+        // The clear_input_buffer() below will now correctly consume the rest of the bad input line
+    }
+    clear_input_buffer(); // Crucial: Clears newline from good input, or the rest of the bad input line if cin was bad and is now cleared.
+}
+
+void showTasksByDueDate() {
+    std::cout << "--- Tasks by Due Date ---" << std::endl;
+    std::cout << "1. Due This Week" << std::endl;
+    std::cout << "2. Due Between Two Dates" << std::endl;
+    std::cout << "3. Overdue by More Than N Days" << std::endl;
+    std::cout << "Enter your choice (1-3): ";
+    int choice;
+    std::cin >> choice;
+    if (!std::cin.good()) {
+        std::cout << "<Invalid input. Please enter a number.>" << std::endl;
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        return;
+    }
+    clear_input_buffer(); // Consume newline
+
+    // Each choice is one range lookup in the deadline index (scheduler_core.h)
+    CivilDate today = CivilDate::today();
+    std::vector<size_t> found;
+    if (choice == 1) {
+        CivilDate monday = today.weekStart();
+        found = taskPriorityIndex.pendingDueBetween(monday, monday.plusDays(6));
+        std::cout << "\nPending tasks due " << monday << " to " << monday.plusDays(6) << ":" << std::endl;
+    } else if (choice == 2) {
+        CivilDate first = promptForDate("Enter start date (YYYY-MM-DD): ");
+        CivilDate last = promptForDate("Enter end date (YYYY-MM-DD): ");
+        if (last < first) std::swap(first, last);
+        found = taskPriorityIndex.pendingDueBetween(first, last);
+        std::cout << "\nPending tasks due " << first << " to " << last << ":" << std::endl;
+    } else if (choice == 3) {
+        int days;
+        while (true) {
+            std::cout << "Enter number of days: ";
+            std::cin >> days;
+            if (std::cin.good() && days >= 0) {
+                clear_input_buffer();
+                break;
+            }
+            std::cout << "<Invalid input. Please enter 0 or a positive number.>" << std::endl;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        found = taskPriorityIndex.pendingOverdueBy(today, days);
+        std::cout << "\nPending tasks overdue by more than " << days << " day(s):" << std::endl;
+    } else {
+        std::cout << "<Invalid choice.>" << std::endl;
+        return;
+    }
+
+    if (found.empty()) {
+        std::cout << "<No matching tasks>" << std::endl;
+    }
+    for (size_t i = 0; i < found.size(); ++i) {
+        const auto& task = tasks[found[i]];
+        std::cout << i + 1 << ". Name: " << task.name
+                  << " | Subject: " << task.subject
+                  << " | Deadline: " << task.deadline
+                  << " | Urgency: " << urgencyToString(task.urgency)
+                  << " | Infos: " << task.infos
+                  << std::endl;
+    }
+    std::cout << "\nPress Enter to return to the menu...";
+    std::string dummy;
+    std::getline(std::cin, dummy);
+}
+
+void deleteTask() {
+    if (taskCount() == 0) {
+        std::cout << "<No tasks to delete.>" << std::endl;
+        clear_input_buffer();
+        std::cout << "Press Enter to return to the menu...";
+        std::string dummy;
+        std::getline(std::cin, dummy);
+        return;
+    }
+
+    std::cout << "--- Delete Task ---" << std::endl;
+    std::cout << "Available Tasks:" << std::endl;
+    std::vector<size_t> listed; // Slots of the live tasks, in list order
+    listed.reserve(taskCount());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (!tasks[i].removed) listed.push_back(i);
+    }
+    for (size_t i = 0; i < listed.size(); ++i) {
+        const auto& task = tasks[listed[i]];
+        std::cout << i + 1 << ". Name: " << task.name
+                  << " | Subject: " << task.subject
+                  << " | Deadline: " << task.deadline
+                  << " | Urgency: " << urgencyToString(task.urgency) // urgencyToString is in this file
+                  << " | Status: " << (task.completed ? "Completed" : "Pending")
+                  << std::endl;
+    }
+
+    int choice_num;
+    while (true) {
+        std::cout << "Enter the number of the task to delete (or 0 to cancel): ";
+        std::cin >> choice_num;
+        if (std::cin.good()) {
+            clear_input_buffer(); // Consume newline
+            if (choice_num >= 0 && static_cast<size_t>(choice_num) <= listed.size()) {
+                break;
+            } else {
+                std::cout << "<Invalid task number. Please try again.>" << std::endl;
+            }
+        } else {
+            std::cout << "<Invalid input. Please enter a number.>" << std::endl;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+
+    if (choice_num == 0) {
+        std::cout << "Deletion cancelled." << std::endl;
+        return;
+    }
+
+    size_t taskIndex = listed[choice_num - 1];
+    TaskDetails taskToDelete = tasks[taskIndex];
+
+    std::string confirmStr;
+    while(true) {
+        std::cout << "Are you sure you want to delete task '" << taskToDelete.name << "'? (yes/no): ";
+        std::getline(std::cin, confirmStr); // std::cin was cleared by clear_input_buffer
+        std::transform(confirmStr.begin(), confirmStr.end(), confirmStr.begin(), ::tolower);
+        if (confirmStr == "yes" || confirmStr == "y" || confirmStr == "no" || confirmStr == "n") {
+            break;
+        }
+        std::cout << "<Invalid input. Please type 'yes' or 'no'.>" << std::endl;
+    }
+
+    if (confirmStr == "yes" || confirmStr == "y") {
+        removeTaskAt(taskIndex);
+        std::cout << "Task '" << taskToDelete.name << "' deleted successfully." << std::endl;
+        journalTaskDeleted(taskIndex); // from file_handler.h
+    } else {
+        std::cout << "Deletion cancelled." << std::endl;
+    }
+}
+
+void taskManagerMenu() {
+    int choice;
+    bool running = true;
+    while (running) {
+        displayTaskManagerMenu(); // Part of scheduler_planner.cpp
+        std::cin >> choice;
+        if (std::cin.good()) {
+            clear_input_buffer(); // From utils.h
+            switch (choice) {
+                case 1: showTasks(); break;   // Part of scheduler_planner.cpp
+                case 2: addTask(); break;     // Part of scheduler_planner.cpp
+                case 3: deleteTask(); break;  // Part of scheduler_planner.cpp
+                case 4: showTasksByDueDate(); break; // Part of scheduler_planner.cpp
+                case 5: running = false; std::cout << "Returning to Scheduler/Planner Menu..." << std::endl; break;
+                default: std::cout << "Invalid choice. Please enter a number between 1 and 5." << std::endl; break;
+            }
+        } else {
+            std::cout << "Invalid input. Please enter a number." << std::endl;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+}
+
+// This is the top-level menu for this module
+void schedulerPlannerMenu() {
+    ensureScheduleLoaded(); // Blocks only if the background load hasn't finished yet
+    ensureTasksLoaded();
+    int choice;
+    bool running = true;
+    while (running) {
+        displaySchedulerPlannerMenu(); // Part of scheduler_planner.cpp
+        std::cin >> choice;
+        if (std::cin.good()) {
+            clear_input_buffer(); // From utils.h
+            switch (choice) {
+                case 1: calendarMenu(); break;       // Part of scheduler_planner.cpp
+                case 2: classSchedulerMenu(); break; // Part of scheduler_planner.cpp
+                case 3: taskManagerMenu(); break;    // Part of scheduler_planner.cpp
+                case 4: running = false; std::cout << "Returning to Main Menu..." << std::endl; break;
+                default: std::cout << "Invalid choice. Please enter a number between 1 and 4." << std::endl; break;
+            }
+        } else {
+            std::cout << "Invalid input. Please enter a number." << std::endl;
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+    }
+}
@@ -1,57 +1,42 @@
-#ifndef SCHEDULER_PLANNER_H
-#define SCHEDULER_PLANNER_H
-
-#include <string>
-#include <vector>
-#include <iostream> // For std::cout, std::cin in menu/display functions
-#include <set>      // For std::set in addTask subject handling (can be forward declared if only in .cpp)
-
-// --- Data structures ---
-struct ClassDetails {
-    std::string subject;
-    std::vector<std::string> daysOfWeek;
-    std::string startTime;
-    std::string endTime;
-    std::string venue;
-};
-
-struct TaskDetails {
-    std::string name;
-    std::string subject;
-    std::string infos;
-    std::string deadlineDate; // Format "YYYY-MM-DD"
-    int urgency;             // 1:High, 2:Moderate, 3:Low
-    bool completed;
-
-    TaskDetails() : urgency(3), completed(false) {}
-};
-
-// --- Function Declarations ---
-
-// Calendar
-void displayCalendar(); // Uses ClassDetails, TaskDetails, utils::getCurrentDateYYYYMMDD, utils::getCurrentDayOfWeek, utils::urgencyToString
-
-// Class Scheduler
-void classSchedulerMenu();    // Calls displayClassScheduleMenu, addClass, editClass
-void displayClassSchedule();  // Uses ClassDetails
-void addClass();              // Uses ClassDetails, utils::parseDaysOfWeek, utils::isValidTimeFormat, checkClassConflict, file_handler::saveClassScheduleToFile
-void editClass();             // Uses ClassDetails, utils::parseDaysOfWeek, utils::isValidTimeFormat, checkClassConflict, file_handler::saveClassScheduleToFile
-bool checkClassConflict(const ClassDetails& classToValidate, int editingClassIndex = -1); // Uses ClassDetails, utils::timeToMinutes
-
-// Task Manager
-void taskManagerMenu();   // Calls displayTaskManagerMenu, showTasks, addTask, deleteTask
-void addTask();           // Uses TaskDetails, ClassDetails (for subject list), file_handler::saveTasksToFile
-void showTasks();         // Uses TaskDetails, utils::urgencyToString, file_handler::saveTasksToFile
-void deleteTask();        // Uses TaskDetails, utils::urgencyToString, file_handler::saveTasksToFile
-std::string urgencyToString(int urgency); // Simple utility, but closely tied to TaskDetails display
-
-// Menu Display functions specific to Scheduler/Planner
-void displaySchedulerPlannerMenu(); // Specific menu display
-void displayClassScheduleMenu(); // Calls displayClassSchedule
-void displayTaskManagerMenu();
-void schedulerPlannerMenu(); // Top-level menu for this module
-
-// Subject retrieval
-std::vector<std::string> get_scheduler_subjects();
-
-#endif // SCHEDULER_PLANNER_H
+#ifndef SCHEDULER_PLANNER_H
+#define SCHEDULER_PLANNER_H
+
+#include <string>
+#include <vector>
+#include <iostream> // For std::cout, std::cin in menu/display functions
+#include "scheduler_core.h" // Data structures, indexes and mutations behind these menus
+#include "timetable_solver.h" // For TimetableSubject, TimetableSolution
+
+// --- Function Declarations ---
+
+// Calendar
+void calendarMenu();       // Calls displayCalendarMenu, displayCalendar, displayWeekAgenda, displayMonthAgenda, termSettingsMenu
+void displayCalendar();    // Today's classes (respecting the term calendar) and tasks due or overdue
+void displayWeekAgenda();  // Monday-Sunday agenda; uses ClassOccurrenceCursor and taskPriorityIndex
+void displayMonthAgenda(); // Same, for a calendar month, listing only days with entries
+void termSettingsMenu();   // Term dates, holidays and make-up days; uses file_handler::saveTermCalendarToFile
+
+// Class Scheduler
+void classSchedulerMenu();    // Calls displayClassScheduleMenu, addClass, editClass, planSections
+void displayClassSchedule();  // Uses ClassDetails
+void addClass();              // Uses ClassDetails, utils::parseDaysOfWeek, utils::timeToMinutes, checkClassConflict, file_handler::saveClassScheduleToFile
+void editClass();             // Uses ClassDetails, utils::parseDaysOfWeek, utils::timeToMinutes, checkClassConflict, file_handler::saveClassScheduleToFile
+void planSections();          // Reads candidate sections from CSV, ranks conflict-free combinations with solveTimetable, adds the one picked
+void printTimetableSolution(size_t rank, const std::vector<TimetableSubject>& subjects, const TimetableSolution& solution); // Also used by the CLI
+bool checkClassConflict(const ClassDetails& classToValidate, int editingClassIndex = -1); // Uses ClassDetails, classConflictIndex
+
+// Task Manager
+void taskManagerMenu();   // Calls displayTaskManagerMenu, showTasks, addTask, deleteTask, showTasksByDueDate
+void addTask();           // Uses TaskDetails, ClassDetails (for subject list), file_handler::saveTasksToFile
+void showTasks();         // Uses TaskDetails, utils::urgencyToString, file_handler::saveTasksToFile
+void showTasksByDueDate(); // This week, a date range, or overdue by more than N days; uses taskPriorityIndex
+void deleteTask();        // Uses TaskDetails, utils::urgencyToString, file_handler::saveTasksToFile
+
+// Menu Display functions specific to Scheduler/Planner
+void displaySchedulerPlannerMenu(); // Specific menu display
+void displayCalendarMenu();
+void displayClassScheduleMenu(); // Calls displayClassSchedule
+void displayTaskManagerMenu();
+void schedulerPlannerMenu(); // Top-level menu for this module
+
+#endif // SCHEDULER_PLANNER_H
@@ -0,0 +1,74 @@
+#include "spaced_repetition.h"
+#include "utils.h" // For INVALID_DAY_NUMBER
+#include <cmath>   // For std::lround
+
+// SM-2 grades a review 0-5; a "y" answer counts as 4 (correct with some effort), "n" as 1.
+static const int RECALLED_GRADE = 4;
+static const int FORGOTTEN_GRADE = 1;
+
+void review_card_memory(CardMemory& memory, bool recalled, int today) {
+    int grade = recalled ? RECALLED_GRADE : FORGOTTEN_GRADE;
+    memory.ease += 0.1 - (5 - grade) * (0.08 + (5 - grade) * 0.02);
+    if (memory.ease < SM2_MIN_EASE) memory.ease = SM2_MIN_EASE;
+
+    if (recalled) {
+        if (memory.repetitions == 0) {
+            memory.interval_days = 1;
+        } else if (memory.repetitions == 1) {
+            memory.interval_days = 6;
+        } else {
+            memory.interval_days = static_cast<int>(std::lround(memory.interval_days * memory.ease));
+        }
+        memory.repetitions++;
+    } else {
+        if (memory.repetitions > 0) memory.lapses++;
+        memory.repetitions = 0;
+        memory.interval_days = 1;
+    }
+    memory.due_day = today + memory.interval_days;
+}
+
+void sync_due_index(Deck& deck) {
+    for (size_t i = deck.due_indexed_cards; i < deck.cards.size(); ++i) {
+        deck.due_index.insert(std::make_pair(deck.cards.memory(i).due_day, i));
+    }
+    deck.due_indexed_cards = deck.cards.size();
+}
+
+void reset_due_index(Deck& deck) {
+    deck.due_index.clear();
+    deck.due_indexed_cards = 0;
+    sync_due_index(deck);
+}
+
+std::vector<size_t> due_cards(Deck& deck, int today, size_t limit) {
+    sync_due_index(deck);
+    std::vector<size_t> result;
+    for (auto it = deck.due_index.begin(); it != deck.due_index.end() && it->first <= today; ++it) {
+        if (limit != 0 && result.size() == limit) break;
+        result.push_back(it->second);
+    }
+    return result;
+}
+
+size_t count_due_cards(Deck& deck, int today) {
+    sync_due_index(deck);
+    // upper_bound of (today, max) is the first entry due after today.
+    auto end = deck.due_index.upper_bound(std::make_pair(today, static_cast<size_t>(-1)));
+    size_t count = 0;
+    for (auto it = deck.due_index.begin(); it != end; ++it) count++;
+    return count;
+}
+
+int next_due_day(Deck& deck) {
+    sync_due_index(deck);
+    return deck.due_index.empty() ? INVALID_DAY_NUMBER : deck.due_index.begin()->first;
+}
+
+void review_card(Deck& deck, size_t card_index, bool recalled, int today) {
+    sync_due_index(deck);
+    CardMemory& memory = deck.cards.memory(card_index);
+    deck.due_index.erase(std::make_pair(memory.due_day, card_index));
+    review_card_memory(memory, recalled, today);
+    deck.due_index.insert(std::make_pair(memory.due_day, card_index));
+}
@@ -0,0 +1,30 @@
+#ifndef SPACED_REPETITION_H
+#define SPACED_REPETITION_H
+
+#include <vector>
+#include <cstddef>
+#include "study_core.h" // For Deck, CardMemory
+
+// --- Spaced repetition (SM-2) ---
+// Each card carries a CardMemory. A correct answer grows the review interval
+// (1 day, 6 days, then interval * ease); a wrong one resets it to 1 day, counts
+// a lapse and lowers the ease. Each deck keeps its cards ordered by due day in
+// Deck::due_index, so collecting today's reviews costs O(log n + due cards).
+
+const double SM2_MIN_EASE = 1.3;
+
+// Applies one review graded from a y/n answer. `today` is a day number (utils.h).
+void review_card_memory(CardMemory& memory, bool recalled, int today);
+
+void sync_due_index(Deck& deck);  // Indexes cards appended since the last call
+void reset_due_index(Deck& deck); // Re-indexes every card (after their memory was replaced)
+
+// Card indices due on or before `today`, earliest first. limit == 0 returns all of them.
+std::vector<size_t> due_cards(Deck& deck, int today, size_t limit = 0);
+size_t count_due_cards(Deck& deck, int today);
+int next_due_day(Deck& deck); // INVALID_DAY_NUMBER if the deck is empty
+
+// Reviews one card and moves it to its new place in the deck's due index.
+void review_card(Deck& deck, size_t card_index, bool recalled, int today);
+
+#endif // SPACED_REPETITION_H
@@ -0,0 +1,57 @@
+#include "startup_loader.h"
+#include "file_handler.h" // For the four load functions
+#include <future>
+
+enum StoreId {
+    STORE_SCHEDULE,
+    STORE_TASKS,
+    STORE_FLASHCARDS,
+    STORE_NOTEBOOKS,
+    STORE_COUNT
+};
+
+typedef void (*LoadFunction)();
+
+// The term calendar is a few lines and only used together with the classes,
+// so it is loaded on the schedule's worker.
+static void loadScheduleAndTerm() {
+    loadClassScheduleFromFile();
+    loadTermCalendarFromFile();
+}
+
+static const LoadFunction storeLoaders[STORE_COUNT] = {
+    loadScheduleAndTerm,
+    loadTasksFromFile,
+    load_flashcards_from_file,
+    load_notebooks_from_file
+};
+
+// Future-like handle per store. Only the main thread starts or waits on them.
+static std::shared_future<void> storeHandles[STORE_COUNT];
+
+static void ensureLoaded(StoreId store) {
+    if (!storeHandles[store].valid()) {
+        // Not started in the background: load now, on the calling thread.
+        storeHandles[store] = std::async(std::launch::deferred, storeLoaders[store]).share();
+    }
+    storeHandles[store].get(); // Waits if still loading; rethrows anything the loader threw
+}
+
+void startBackgroundLoad() {
+    for (int store = 0; store < STORE_COUNT; ++store) {
+        if (!storeHandles[store].valid()) {
+            storeHandles[store] = std::async(std::launch::async, storeLoaders[store]).share();
+        }
+    }
+}
+
+void ensureScheduleLoaded() { ensureLoaded(STORE_SCHEDULE); }
+void ensureTasksLoaded() { ensureLoaded(STORE_TASKS); }
+void ensureFlashcardsLoaded() { ensureLoaded(STORE_FLASHCARDS); }
+void ensureNotebooksLoaded() { ensureLoaded(STORE_NOTEBOOKS); }
+
+void waitForAllStores() {
+    for (int store = 0; store < STORE_COUNT; ++store) {
+        ensureLoaded(static_cast<StoreId>(store));
+    }
+}
@@ -0,0 +1,19 @@
+#ifndef STARTUP_LOADER_H
+#define STARTUP_LOADER_H
+
+// --- Parallel startup loading ---
+// startBackgroundLoad() reads and parses schedule.dat, tasks.dat, flashcards.dat
+// and notebooks.dat (plus their journals) concurrently, one worker per store, so
+// startup costs as much as the slowest file rather than the sum of all four.
+// Code that touches a store calls the matching ensure*Loaded() first; it blocks
+// only if that store's load is still running. If startBackgroundLoad() was never
+// called, ensure*Loaded() loads the store synchronously on first use.
+
+void startBackgroundLoad();
+void ensureScheduleLoaded();
+void ensureTasksLoaded();
+void ensureFlashcardsLoaded();
+void ensureNotebooksLoaded();
+void waitForAllStores(); // Blocks until every store is loaded (e.g. before exit)
+
+#endif // STARTUP_LOADER_H
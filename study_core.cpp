@@ -0,0 +1,46 @@
+#include "study_core.h"
+#include "file_handler.h"     // For the flashcard_decks and notebooks declarations
+#include "subject_registry.h" // For subject_registry
+#include "note_search.h"      // For note_search_index
+
+// Definition of global data vectors for Study Hub
+std::vector<Deck> flashcard_decks;
+std::vector<Notebook> notebooks;
+MonotonicArena notebooks_arena;
+
+void clear_notebooks() {
+    notebooks.clear();
+    notebooks_arena.release();
+}
+
+size_t append_deck(const Deck& deck) {
+    flashcard_decks.push_back(deck);
+    subject_registry.add_deck(flashcard_decks.size() - 1, deck.subject);
+    return flashcard_decks.size() - 1;
+}
+
+void append_card(size_t deck_index, const Card& card) {
+    Deck& deck = flashcard_decks[deck_index];
+    deck.cards.push_back(card);
+    deck.dirty = true; // The due index picks the card up lazily (spaced_repetition.h)
+}
+
+void remove_deck_at(size_t deck_index) {
+    subject_registry.remove_deck(deck_index, flashcard_decks[deck_index].subject);
+    flashcard_decks.erase(flashcard_decks.begin() + deck_index);
+}
+
+size_t append_note(const std::string& subject, const Note& note) {
+    size_t notebook_index = subject_registry.notebook_for(subject);
+    if (notebook_index == NO_NOTEBOOK) { // First note for this subject
+        notebooks.emplace_back();
+        notebooks.back().subject = subject;
+        notebook_index = notebooks.size() - 1;
+        subject_registry.set_notebook(notebook_index, subject);
+    }
+    Notebook& notebook = notebooks[notebook_index];
+    notebook.notes.push_back(note);
+    notebook.dirty = true;
+    note_search_index.add_note(notebook_index, notebook.notes.size() - 1, note);
+    return notebook_index;
+}
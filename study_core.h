@@ -0,0 +1,70 @@
+#ifndef STUDY_CORE_H
+#define STUDY_CORE_H
+
+#include <string>
+#include <vector>
+#include <set>
+#include <utility>
+#include "card_store.h" // For Card, CardMemory and the column-wise CardStore
+
+// Study Hub data and the mutations that keep its indexes in sync. Part of
+// libiskaalaman_core: no console I/O here; the menus in study_hub.h are a
+// front-end over it.
+
+// --- Data structures for Study Hub (Flashcards & Notebooks) ---
+struct Deck {
+    std::string subject;
+    std::string title;
+    std::string timestamp;
+    CardStore cards;
+
+    // Save bookkeeping: set dirty whenever the deck changes so save_flashcards_to_file
+    // re-serializes it. A clean deck's text is copied from its byte range in the
+    // flashcards.dat last loaded or saved, so no second copy is kept in memory.
+    bool dirty;
+    size_t snapshot_offset;
+    size_t snapshot_length;
+
+    // Spaced-repetition due index: (due day, card index) for the first
+    // due_indexed_cards cards. Cards are only ever appended, so cards added
+    // later are picked up by sync_due_index (spaced_repetition.h).
+    std::set<std::pair<int, size_t> > due_index;
+    size_t due_indexed_cards;
+
+    Deck() : dirty(true), snapshot_offset(0), snapshot_length(0), due_indexed_cards(0) {}
+};
+
+// Note text lives in notebooks_arena; see below.
+struct Note {
+    StringRef topic_title;
+    StringRef content;
+    StringRef timestamp;
+};
+
+struct Notebook {
+    std::string subject;
+    std::vector<Note> notes;
+
+    bool dirty;             // Same save bookkeeping as Deck, against notebooks.dat
+    size_t snapshot_offset;
+    size_t snapshot_length;
+
+    Notebook() : dirty(true), snapshot_offset(0), snapshot_length(0) {}
+};
+
+// Owns the text of every note (titles, timestamps, content), the bulk of
+// notebooks.dat, so a load makes a few block allocations rather than three or
+// more per note. New notes copy their text in (notebooks_arena.copy) before
+// append_note. Released only by clear_notebooks, together with the notes.
+extern MonotonicArena notebooks_arena;
+void clear_notebooks(); // Empties notebooks and releases notebooks_arena; callers rebuild the indexes
+
+// Deck and note mutations shared by the menus. Like appendTask they keep
+// subject_registry and note_search_index current but do not journal;
+// callers follow up with the matching journal_* call (file_handler.h).
+size_t append_deck(const Deck& deck);                 // Returns the new deck's index
+void append_card(size_t deck_index, const Card& card);
+void remove_deck_at(size_t deck_index);               // Later decks shift down by one
+size_t append_note(const std::string& subject, const Note& note); // Creates the subject's notebook if needed; returns its index
+
+#endif // STUDY_CORE_H
@@ -0,0 +1,191 @@
+#include "study_events.h"
+#include "study_core.h" // For Deck
+#include <cstring>     // For std::memcmp, std::memcpy
+#include <ctime>       // For std::time
+#include <map>
+#include <unordered_map>
+#include <algorithm>   // For std::sort
+#include <sys/stat.h>  // For stat() when trimming a torn tail
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <unistd.h> // For truncate()
+    #define ISKAALAMAN_HAVE_POSIX_IO 1
+#else
+    #include <fstream>
+    #include <iterator>
+    #include "atomic_file.h" // Without truncate() the kept prefix is rewritten instead
+#endif
+
+const std::string STUDY_EVENTS_FILE = "study_events.log";
+
+static const char STUDY_EVENT_MAGIC[8] = {'I', 'S', 'K', 'E', 'V', 'L', 'O', 'G'};
+static const size_t EVENTS_PER_READ = 4096; // Events pulled per fread while aggregating
+static const int64_t SECONDS_PER_DAY = 86400;
+
+uint32_t study_deck_id(const Deck& deck) {
+    uint32_t hash = 2166136261u;
+    auto mix = [&hash](const std::string& text) {
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 16777619u;
+        }
+    };
+    mix(deck.timestamp);
+    mix("\n");
+    mix(deck.title);
+    return hash;
+}
+
+// --- StudyEventLog ---
+// Cuts the log back to the header plus whole events. An event torn by a crash
+// would otherwise shift every event appended after it. A torn header empties the log.
+static bool trim_torn_tail(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return true; // New log
+    size_t size = static_cast<size_t>(st.st_size);
+    size_t keep = size < sizeof(StudyEventLogHeader)
+        ? 0
+        : size - (size - sizeof(StudyEventLogHeader)) % sizeof(StudyEvent);
+    if (keep == size) return true;
+#ifdef ISKAALAMAN_HAVE_POSIX_IO
+    return ::truncate(path.c_str(), static_cast<off_t>(keep)) == 0;
+#else
+    std::ifstream infile(path.c_str(), std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+    contents.resize(keep);
+    return write_file_atomically(path, contents);
+#endif
+}
+
+bool StudyEventLog::open(const std::string& path) {
+    close();
+    if (!trim_torn_tail(path)) return false;
+    file = std::fopen(path.c_str(), "ab");
+    if (!file) return false;
+    std::fseek(file, 0, SEEK_END);
+    if (std::ftell(file) == 0) {
+        StudyEventLogHeader header;
+        std::memcpy(header.magic, STUDY_EVENT_MAGIC, sizeof(header.magic));
+        header.version = STUDY_EVENT_LOG_VERSION;
+        header.endianTag = STUDY_EVENT_ENDIAN_TAG;
+        std::fwrite(&header, sizeof(header), 1, file);
+    }
+    return true;
+}
+
+void StudyEventLog::record(const Deck& deck, size_t card_index, bool correct, int mode, unsigned attempt, long long think_ms) {
+    if (!file) return;
+    StudyEvent event;
+    std::memset(&event, 0, sizeof(event)); // Keep padding bytes deterministic
+    event.timestamp = static_cast<int64_t>(std::time(nullptr));
+    event.deckId = study_deck_id(deck);
+    event.cardIndex = static_cast<uint32_t>(card_index);
+    event.thinkMs = static_cast<uint32_t>(think_ms < 0 ? 0 : think_ms);
+    event.correct = correct ? 1 : 0;
+    event.mode = static_cast<uint8_t>(mode);
+    event.attempt = static_cast<uint16_t>(attempt > 0xFFFF ? 0xFFFF : attempt);
+    std::fwrite(&event, sizeof(event), 1, file);
+}
+
+void StudyEventLog::close() {
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+// --- Aggregation ---
+const char* retention_bucket_label(int bucket) {
+    static const char* labels[RETENTION_BUCKETS] = {"same day", "1 day", "2-3 days", "4-7 days", "8-14 days", "15-30 days", "31+ days"};
+    return bucket >= 0 && bucket < RETENTION_BUCKETS ? labels[bucket] : "?";
+}
+
+static int retention_bucket(int64_t gap_seconds) {
+    int64_t days = gap_seconds / SECONDS_PER_DAY;
+    if (days < 1) return 0;
+    if (days < 2) return 1;
+    if (days < 4) return 2;
+    if (days < 8) return 3;
+    if (days < 15) return 4;
+    if (days < 31) return 5;
+    return 6;
+}
+
+bool aggregate_study_events(StudyStatistics& stats, const std::string& path) {
+    stats = StudyStatistics();
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    StudyEventLogHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, STUDY_EVENT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != STUDY_EVENT_LOG_VERSION || header.endianTag != STUDY_EVENT_ENDIAN_TAG) {
+        std::fclose(file);
+        return false;
+    }
+
+    std::unordered_map<uint64_t, size_t> card_slots; // (deckId << 32 | cardIndex) -> index in stats.cards
+    std::map<uint32_t, size_t> deck_slots;           // deckId -> index in stats.decks
+    std::vector<StudyEvent> chunk(EVENTS_PER_READ);
+    size_t read_count;
+    while ((read_count = std::fread(&chunk[0], sizeof(StudyEvent), chunk.size(), file)) > 0) {
+        for (size_t i = 0; i < read_count; ++i) {
+            const StudyEvent& event = chunk[i];
+            bool correct = event.correct != 0;
+            stats.eventCount++;
+            stats.overall.add(correct);
+
+            auto deck_slot = deck_slots.find(event.deckId);
+            if (deck_slot == deck_slots.end()) {
+                DeckStatistics deck_stats;
+                deck_stats.deckId = event.deckId;
+                deck_slot = deck_slots.insert(std::make_pair(event.deckId, stats.decks.size())).first;
+                stats.decks.push_back(deck_stats);
+            }
+            DeckStatistics& deck_stats = stats.decks[deck_slot->second];
+            deck_stats.answers.add(correct);
+
+            uint64_t key = (static_cast<uint64_t>(event.deckId) << 32) | event.cardIndex;
+            auto card_slot = card_slots.find(key);
+            if (card_slot == card_slots.end()) {
+                CardStatistics card_stats;
+                card_stats.deckId = event.deckId;
+                card_stats.cardIndex = event.cardIndex;
+                card_stats.totalThinkMs = 0;
+                card_stats.lastAnswered = 0;
+                card_slot = card_slots.insert(std::make_pair(key, stats.cards.size())).first;
+                stats.cards.push_back(card_stats);
+            }
+            CardStatistics& card_stats = stats.cards[card_slot->second];
+            // Only the first showing of a card in a session says whether it was remembered.
+            if (card_stats.answers.answered > 0 && event.attempt <= 1) {
+                deck_stats.retention[retention_bucket(event.timestamp - card_stats.lastAnswered)].add(correct);
+            }
+            card_stats.answers.add(correct);
+            card_stats.totalThinkMs += event.thinkMs;
+            card_stats.lastAnswered = event.timestamp;
+        }
+    }
+    std::fclose(file);
+
+    std::sort(stats.cards.begin(), stats.cards.end(), [](const CardStatistics& a, const CardStatistics& b) {
+        return a.difficulty() > b.difficulty();
+    });
+    return true;
+}
+
+std::vector<std::pair<std::string, AnswerTally> > subject_accuracy(const StudyStatistics& stats, const std::vector<Deck>& decks) {
+    std::unordered_map<uint32_t, const Deck*> deck_by_id;
+    for (const auto& deck : decks) {
+        deck_by_id[study_deck_id(deck)] = &deck;
+    }
+    std::map<std::string, AnswerTally> by_subject;
+    for (const auto& deck_stats : stats.decks) {
+        auto it = deck_by_id.find(deck_stats.deckId);
+        if (it == deck_by_id.end()) continue;
+        AnswerTally& tally = by_subject[it->second->subject];
+        tally.answered += deck_stats.answers.answered;
+        tally.correct += deck_stats.answers.correct;
+    }
+    return std::vector<std::pair<std::string, AnswerTally> >(by_subject.begin(), by_subject.end());
+}
@@ -0,0 +1,108 @@
+#ifndef STUDY_EVENTS_H
+#define STUDY_EVENTS_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+struct Deck;
+
+// --- Study event log (study_events.log) ---
+// Every answer in a study session is appended as one fixed-size StudyEvent.
+// Layout, all integers in host byte order:
+//   StudyEventLogHeader
+//   StudyEvent x N      (appended in time order)
+// The statistics below are computed by streaming the log in fixed-size
+// chunks, so memory grows with the number of distinct cards and decks, not
+// with the length of the history.
+
+extern const std::string STUDY_EVENTS_FILE;
+const uint32_t STUDY_EVENT_LOG_VERSION = 1;
+const uint32_t STUDY_EVENT_ENDIAN_TAG = 0x01020304;
+
+struct StudyEventLogHeader {
+    char magic[8];      // "ISKEVLOG"
+    uint32_t version;
+    uint32_t endianTag; // STUDY_EVENT_ENDIAN_TAG as written by the producing host
+};
+
+struct StudyEvent {
+    int64_t timestamp; // Unix seconds when the answer was given
+    uint32_t deckId;   // study_deck_id() of the deck
+    uint32_t cardIndex;
+    uint32_t thinkMs;  // From showing the card to flipping it
+    uint8_t correct;   // 1 = answered right, 0 = missed
+    uint8_t mode;      // StudyMode the session ran in
+    uint16_t attempt;  // 1 for the first time the card was shown in the session, 2 for the next...
+};
+
+// Stable id for a deck across renumbering: FNV-1a hash of its creation timestamp and title.
+uint32_t study_deck_id(const Deck& deck);
+
+// Appends events for one study session. Events are buffered and written when the log closes.
+class StudyEventLog {
+public:
+    StudyEventLog() : file(nullptr) {}
+    ~StudyEventLog() { close(); }
+
+    // Writes the header if the log is new, after dropping any partial event a crash left at the end.
+    bool open(const std::string& path = STUDY_EVENTS_FILE);
+    void record(const Deck& deck, size_t card_index, bool correct, int mode, unsigned attempt, long long think_ms);
+    void close();
+
+private:
+    StudyEventLog(const StudyEventLog&);            // Not copyable
+    StudyEventLog& operator=(const StudyEventLog&);
+
+    std::FILE* file;
+};
+
+// --- Aggregated statistics ---
+// Retention is bucketed by the days since the card's previous answer:
+// same day, 1, 2-3, 4-7, 8-14, 15-30 and 31+ days.
+const int RETENTION_BUCKETS = 7;
+const char* retention_bucket_label(int bucket);
+
+struct AnswerTally {
+    uint64_t answered;
+    uint64_t correct;
+
+    AnswerTally() : answered(0), correct(0) {}
+    void add(bool was_correct) { answered++; if (was_correct) correct++; }
+    double accuracy() const { return answered == 0 ? 0.0 : static_cast<double>(correct) / answered; }
+};
+
+struct CardStatistics {
+    uint32_t deckId;
+    uint32_t cardIndex;
+    AnswerTally answers;
+    uint64_t totalThinkMs;
+    int64_t lastAnswered;
+    // Share of answers missed, smoothed towards 0.5 so one miss is not "100% hard".
+    double difficulty() const { return (answers.answered - answers.correct + 1.0) / (answers.answered + 2.0); }
+};
+
+struct DeckStatistics {
+    uint32_t deckId;
+    AnswerTally answers;
+    AnswerTally retention[RETENTION_BUCKETS]; // Answers to cards seen before, by gap since the last answer
+};
+
+struct StudyStatistics {
+    uint64_t eventCount;
+    std::vector<CardStatistics> cards; // Hardest first
+    std::vector<DeckStatistics> decks;
+    AnswerTally overall;
+
+    StudyStatistics() : eventCount(0) {}
+};
+
+// Streams the whole log. Returns false if it is missing or not a study event log.
+bool aggregate_study_events(StudyStatistics& stats, const std::string& path = STUDY_EVENTS_FILE);
+
+// Rolls deck totals up by Deck::subject, sorted by subject. Decks that no longer exist are skipped.
+std::vector<std::pair<std::string, AnswerTally> > subject_accuracy(const StudyStatistics& stats, const std::vector<Deck>& decks);
+
+#endif // STUDY_EVENTS_H
@@ -0,0 +1,184 @@
+#include "subject_registry.h"
+#include "file_handler.h" // For the extern store vectors
+#include "scheduler_core.h"
+#include "study_core.h"
+#include <algorithm>      // For std::find, std::lower_bound
+
+SubjectRegistry subject_registry;
+
+// Removes one occurrence of `value` from an unordered index list.
+static void erase_index(std::vector<size_t>& list, size_t value) {
+    auto it = std::find(list.begin(), list.end(), value);
+    if (it != list.end()) {
+        *it = list.back();
+        list.pop_back();
+    }
+}
+
+SubjectId SubjectRegistry::intern_locked(const std::string& subject) {
+    auto it = ids.find(subject);
+    if (it != ids.end()) return it->second;
+    SubjectId id = static_cast<SubjectId>(entries.size());
+    entries.push_back(SubjectEntry());
+    entries.back().name = subject;
+    ids[subject] = id;
+    return id;
+}
+
+const SubjectRegistry::SubjectEntry* SubjectRegistry::find_locked(const std::string& subject) const {
+    auto it = ids.find(subject);
+    return it == ids.end() ? nullptr : &entries[it->second];
+}
+
+SubjectId SubjectRegistry::intern(const std::string& subject) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return intern_locked(subject);
+}
+
+SubjectId SubjectRegistry::find(const std::string& subject) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(subject);
+    return it == ids.end() ? NO_SUBJECT : it->second;
+}
+
+std::string SubjectRegistry::name(SubjectId id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return id < entries.size() ? entries[id].name : std::string();
+}
+
+// --- Classes ---
+void SubjectRegistry::add_class(size_t class_index, const std::string& subject) {
+    std::lock_guard<std::mutex> lock(mutex);
+    SubjectEntry& entry = entries[intern_locked(subject)];
+    entry.classes.push_back(class_index);
+    if (entry.classes.size() == 1 && !subject.empty()) {
+        sorted_class_subjects.insert(std::lower_bound(sorted_class_subjects.begin(), sorted_class_subjects.end(), subject), subject);
+    }
+}
+
+void SubjectRegistry::remove_class(size_t class_index, const std::string& subject) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(subject);
+    if (it == ids.end()) return;
+    SubjectEntry& entry = entries[it->second];
+    if (entry.classes.empty()) return;
+    erase_index(entry.classes, class_index);
+    if (entry.classes.empty() && !subject.empty()) {
+        auto pos = std::lower_bound(sorted_class_subjects.begin(), sorted_class_subjects.end(), subject);
+        if (pos != sorted_class_subjects.end() && *pos == subject) sorted_class_subjects.erase(pos);
+    }
+}
+
+void SubjectRegistry::clear_classes() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : entries) entry.classes.clear();
+    sorted_class_subjects.clear();
+}
+
+std::vector<size_t> SubjectRegistry::classes_for(const std::string& subject) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const SubjectEntry* entry = find_locked(subject);
+    return entry ? entry->classes : std::vector<size_t>();
+}
+
+const std::vector<std::string>& SubjectRegistry::class_subjects() const {
+    return sorted_class_subjects; // Only the schedule's owner thread mutates it
+}
+
+// --- Tasks ---
+void SubjectRegistry::add_task(size_t task_index, const std::string& subject) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[intern_locked(subject)].tasks.push_back(task_index);
+}
+
+void SubjectRegistry::remove_task(size_t task_index, const std::string& subject) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(subject);
+    if (it != ids.end()) erase_index(entries[it->second].tasks, task_index);
+}
+
+void SubjectRegistry::clear_tasks() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : entries) entry.tasks.clear();
+}
+
+std::vector<size_t> SubjectRegistry::tasks_for(const std::string& subject) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const SubjectEntry* entry = find_locked(subject);
+    return entry ? entry->tasks : std::vector<size_t>();
+}
+
+// --- Decks ---
+void SubjectRegistry::add_deck(size_t deck_index, const std::string& subject) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[intern_locked(subject)].decks.push_back(deck_index);
+}
+
+void SubjectRegistry::remove_deck(size_t deck_index, const std::string& subject) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = ids.find(subject);
+    if (it != ids.end()) erase_index(entries[it->second].decks, deck_index);
+    for (auto& entry : entries) {
+        for (auto& index : entry.decks) {
+            if (index > deck_index) --index;
+        }
+    }
+}
+
+void SubjectRegistry::clear_decks() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : entries) entry.decks.clear();
+}
+
+std::vector<size_t> SubjectRegistry::decks_for(const std::string& subject) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const SubjectEntry* entry = find_locked(subject);
+    return entry ? entry->decks : std::vector<size_t>();
+}
+
+// --- Notebooks ---
+void SubjectRegistry::set_notebook(size_t notebook_index, const std::string& subject) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[intern_locked(subject)].notebook = notebook_index;
+}
+
+void SubjectRegistry::clear_notebooks() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : entries) entry.notebook = NO_NOTEBOOK;
+}
+
+size_t SubjectRegistry::notebook_for(const std::string& subject) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    const SubjectEntry* entry = find_locked(subject);
+    return entry ? entry->notebook : NO_NOTEBOOK;
+}
+
+// --- Whole-store rebuilds ---
+void rebuild_class_subjects() {
+    subject_registry.clear_classes();
+    for (size_t i = 0; i < classSchedule.size(); ++i) {
+        subject_registry.add_class(i, classSchedule[i].subject);
+    }
+}
+
+void rebuild_task_subjects() {
+    subject_registry.clear_tasks();
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (tasks[i].removed) continue;
+        subject_registry.add_task(i, tasks[i].subject);
+    }
+}
+
+void rebuild_deck_subjects() {
+    subject_registry.clear_decks();
+    for (size_t i = 0; i < flashcard_decks.size(); ++i) {
+        subject_registry.add_deck(i, flashcard_decks[i].subject);
+    }
+}
+
+void rebuild_notebook_subjects() {
+    subject_registry.clear_notebooks();
+    for (size_t i = 0; i < notebooks.size(); ++i) {
+        subject_registry.set_notebook(i, notebooks[i].subject);
+    }
+}
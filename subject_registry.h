@@ -0,0 +1,84 @@
+#ifndef SUBJECT_REGISTRY_H
+#define SUBJECT_REGISTRY_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+// --- Shared subject registry ---
+// Every subject name is interned once to a small integer id. For each id the
+// registry keeps the positions of the class, task, deck and notebook entries
+// that use it, so subject lookups are a hash probe instead of a scan over the
+// stores. Owners of a store update it on every add/edit/delete and rebuild
+// their part after a load (see rebuild_*_subjects below).
+//
+// The stores load on separate threads at startup, so every method locks.
+
+typedef uint32_t SubjectId;
+const SubjectId NO_SUBJECT = 0xFFFFFFFFu;
+const size_t NO_NOTEBOOK = static_cast<size_t>(-1);
+
+class SubjectRegistry {
+public:
+    SubjectId intern(const std::string& subject);     // Adds the subject if it is new
+    SubjectId find(const std::string& subject) const; // NO_SUBJECT if never interned
+    std::string name(SubjectId id) const;
+
+    // Classes (indices into classSchedule)
+    void add_class(size_t class_index, const std::string& subject);
+    void remove_class(size_t class_index, const std::string& subject);
+    void clear_classes();
+    std::vector<size_t> classes_for(const std::string& subject) const;
+    // Distinct non-empty subjects that have at least one class, sorted. Kept
+    // up to date incrementally, so menus can list it on every redraw.
+    const std::vector<std::string>& class_subjects() const;
+
+    // Tasks (indices into tasks)
+    void add_task(size_t task_index, const std::string& subject);
+    void remove_task(size_t task_index, const std::string& subject);
+    void clear_tasks();
+    std::vector<size_t> tasks_for(const std::string& subject) const;
+
+    // Decks (indices into flashcard_decks)
+    void add_deck(size_t deck_index, const std::string& subject);
+    // Also shifts the later deck indices down by one, matching vector::erase. O(number of decks).
+    void remove_deck(size_t deck_index, const std::string& subject);
+    void clear_decks();
+    std::vector<size_t> decks_for(const std::string& subject) const;
+
+    // Notebooks (index into notebooks; one notebook per subject)
+    void set_notebook(size_t notebook_index, const std::string& subject);
+    void clear_notebooks();
+    size_t notebook_for(const std::string& subject) const; // NO_NOTEBOOK if none
+
+private:
+    struct SubjectEntry {
+        std::string name;
+        std::vector<size_t> classes;
+        std::vector<size_t> tasks;
+        std::vector<size_t> decks;
+        size_t notebook;
+
+        SubjectEntry() : notebook(NO_NOTEBOOK) {}
+    };
+
+    SubjectId intern_locked(const std::string& subject);
+    const SubjectEntry* find_locked(const std::string& subject) const;
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, SubjectId> ids;
+    std::vector<SubjectEntry> entries; // Indexed by SubjectId
+    std::vector<std::string> sorted_class_subjects;
+};
+
+extern SubjectRegistry subject_registry;
+
+// Re-register a whole store from its global vector (after loading it).
+void rebuild_class_subjects();
+void rebuild_task_subjects();
+void rebuild_deck_subjects();
+void rebuild_notebook_subjects();
+
+#endif // SUBJECT_REGISTRY_H
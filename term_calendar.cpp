@@ -0,0 +1,140 @@
+#include "term_calendar.h"
+#include <algorithm> // For std::lower_bound
+
+TermCalendar termCalendar;
+
+// Orders holidays and make-up days by date for std::lower_bound.
+template <typename Entry>
+static bool entryBefore(const Entry& entry, CivilDate day) {
+    return entry.date < day;
+}
+
+template <typename Entry>
+static const Entry* entryOn(const std::vector<Entry>& entries, CivilDate day) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), day, entryBefore<Entry>);
+    return it != entries.end() && it->date == day ? &*it : nullptr;
+}
+
+template <typename Entry>
+static bool removeEntryOn(std::vector<Entry>& entries, CivilDate day) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), day, entryBefore<Entry>);
+    if (it == entries.end() || it->date != day) return false;
+    entries.erase(it);
+    return true;
+}
+
+template <typename Entry>
+static void setEntry(std::vector<Entry>& entries, const Entry& entry) {
+    auto it = std::lower_bound(entries.begin(), entries.end(), entry.date, entryBefore<Entry>);
+    if (it != entries.end() && it->date == entry.date) {
+        *it = entry;
+    } else {
+        entries.insert(it, entry);
+    }
+}
+
+void TermCalendar::clear() {
+    firstDay = CivilDate();
+    lastDay = CivilDate();
+    holidays.clear();
+    makeUpDays.clear();
+}
+
+bool TermCalendar::inTerm(CivilDate day) const {
+    if (firstDay.isValid() && day < firstDay) return false;
+    if (lastDay.isValid() && lastDay < day) return false;
+    return true;
+}
+
+const TermHoliday* TermCalendar::holidayOn(CivilDate day) const {
+    return entryOn(holidays, day);
+}
+
+const TermMakeUpDay* TermCalendar::makeUpDayOn(CivilDate day) const {
+    return entryOn(makeUpDays, day);
+}
+
+int TermCalendar::weekdayFollowed(CivilDate day) const {
+    if (!day.isValid() || !inTerm(day) || holidayOn(day)) return -1;
+    const TermMakeUpDay* makeUp = makeUpDayOn(day);
+    return makeUp ? makeUp->followsWeekday : day.weekday();
+}
+
+void TermCalendar::setHoliday(CivilDate day, const std::string& name) {
+    TermHoliday holiday;
+    holiday.date = day;
+    holiday.name = name;
+    setEntry(holidays, holiday);
+}
+
+bool TermCalendar::removeHoliday(CivilDate day) {
+    return removeEntryOn(holidays, day);
+}
+
+void TermCalendar::setMakeUpDay(CivilDate day, int followsWeekday) {
+    TermMakeUpDay makeUp;
+    makeUp.date = day;
+    makeUp.followsWeekday = followsWeekday;
+    setEntry(makeUpDays, makeUp);
+}
+
+bool TermCalendar::removeMakeUpDay(CivilDate day) {
+    return removeEntryOn(makeUpDays, day);
+}
+
+// --- ClassOccurrenceCursor ---
+ClassOccurrenceCursor::ClassOccurrenceCursor(const TermCalendar& term, const ClassConflictIndex& classes,
+                                             CivilDate first, CivilDate last)
+    : term_(term), classes_(classes), day_(first), last_(last), nextHoliday_(0), nextMakeUp_(0),
+      meeting_(classes.meetingsOn(0).end()), meetingsEnd_(classes.meetingsOn(0).end()) {
+    if (!first.isValid() || !last.isValid()) {
+        day_ = CivilDate(1);
+        last_ = CivilDate(0); // Empty range: next() returns false straight away
+        return;
+    }
+    // Days outside the term have no classes, so they are never visited.
+    if (term.firstDay.isValid() && day_ < term.firstDay) day_ = term.firstDay;
+    if (term.lastDay.isValid() && term.lastDay < last_) last_ = term.lastDay;
+    if (last_ < day_) return;
+    nextHoliday_ = static_cast<size_t>(std::lower_bound(term.holidays.begin(), term.holidays.end(), day_,
+                                                        entryBefore<TermHoliday>) - term.holidays.begin());
+    nextMakeUp_ = static_cast<size_t>(std::lower_bound(term.makeUpDays.begin(), term.makeUpDays.end(), day_,
+                                                       entryBefore<TermMakeUpDay>) - term.makeUpDays.begin());
+    enterDay();
+}
+
+void ClassOccurrenceCursor::enterDay() {
+    while (nextHoliday_ < term_.holidays.size() && term_.holidays[nextHoliday_].date < day_) ++nextHoliday_;
+    while (nextMakeUp_ < term_.makeUpDays.size() && term_.makeUpDays[nextMakeUp_].date < day_) ++nextMakeUp_;
+
+    int weekday = day_.weekday();
+    if (nextHoliday_ < term_.holidays.size() && term_.holidays[nextHoliday_].date == day_) {
+        weekday = -1;
+    } else if (nextMakeUp_ < term_.makeUpDays.size() && term_.makeUpDays[nextMakeUp_].date == day_) {
+        weekday = term_.makeUpDays[nextMakeUp_].followsWeekday;
+    }
+    if (weekday < 0 || weekday > 6) {
+        meeting_ = meetingsEnd_; // Empty range
+        return;
+    }
+    const ClassConflictIndex::Meetings& meetings = classes_.meetingsOn(weekday);
+    meeting_ = meetings.begin();
+    meetingsEnd_ = meetings.end();
+}
+
+bool ClassOccurrenceCursor::next(ClassOccurrence& occurrence) {
+    while (!(last_ < day_)) {
+        if (meeting_ != meetingsEnd_) {
+            const ClassInterval& interval = meeting_->second;
+            occurrence.date = day_;
+            occurrence.classIndex = interval.classIndex;
+            occurrence.startMinutes = interval.startMinutes;
+            occurrence.endMinutes = interval.endMinutes;
+            ++meeting_;
+            return true;
+        }
+        day_ = day_.plusDays(1);
+        if (!(last_ < day_)) enterDay();
+    }
+    return false;
+}
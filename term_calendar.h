@@ -0,0 +1,81 @@
+#ifndef TERM_CALENDAR_H
+#define TERM_CALENDAR_H
+
+#include <string>
+#include <vector>
+#include "civil_date.h"     // For CivilDate
+#include "scheduler_core.h" // For ClassConflictIndex, whose per-weekday maps are the weekly timetable
+
+// --- Term calendar ---
+// Classes in classSchedule repeat weekly between the term's first and last day.
+// A holiday cancels every class on its date; a make-up day runs the classes of
+// another weekday instead of its own (e.g. a Saturday that follows Monday's
+// schedule). Holidays and make-up days are kept sorted by date, at most one
+// entry per date, so a walk over a date range can step through them in order.
+struct TermHoliday {
+    CivilDate date;
+    std::string name;
+};
+
+struct TermMakeUpDay {
+    CivilDate date;
+    int followsWeekday; // 0=Sun .. 6=Sat, whose classes meet on `date`
+};
+
+struct TermCalendar {
+    CivilDate firstDay; // Invalid = no term set: classes repeat on every week
+    CivilDate lastDay;
+    std::vector<TermHoliday> holidays;
+    std::vector<TermMakeUpDay> makeUpDays;
+
+    void clear();
+    bool inTerm(CivilDate day) const; // True for every date when no term is set
+    const TermHoliday* holidayOn(CivilDate day) const;     // nullptr if none; O(log holidays)
+    const TermMakeUpDay* makeUpDayOn(CivilDate day) const; // nullptr if none
+    // Weekday whose classes meet on `day`, or -1 if none do (outside the term, or a holiday).
+    int weekdayFollowed(CivilDate day) const;
+
+    // Adding to a date that already has an entry replaces it.
+    void setHoliday(CivilDate day, const std::string& name);
+    bool removeHoliday(CivilDate day);
+    void setMakeUpDay(CivilDate day, int followsWeekday);
+    bool removeMakeUpDay(CivilDate day);
+};
+
+extern TermCalendar termCalendar;
+
+// --- Class occurrences ---
+struct ClassOccurrence {
+    CivilDate date;
+    size_t classIndex; // Position in classSchedule
+    int startMinutes;
+    int endMinutes;
+};
+
+// Produces the class meetings in [first, last] one at a time, by date and then
+// start time, without building a list for the term: each day is resolved to
+// the weekday it follows and that weekday's meetings are read straight from
+// the conflict index. The range is clipped to the term first, and holidays and
+// make-up days are stepped through with cursors, so a walk costs
+// O(days in range + meetings produced + log of the holiday count).
+// The cursor refers to `term` and `classes`; neither may change while it is used.
+class ClassOccurrenceCursor {
+public:
+    ClassOccurrenceCursor(const TermCalendar& term, const ClassConflictIndex& classes, CivilDate first, CivilDate last);
+
+    bool next(ClassOccurrence& occurrence); // False once the range is exhausted
+
+private:
+    void enterDay(); // Points the meeting iterators at day_'s classes
+
+    const TermCalendar& term_;
+    const ClassConflictIndex& classes_;
+    CivilDate day_;
+    CivilDate last_;
+    size_t nextHoliday_; // First holiday on or after day_
+    size_t nextMakeUp_;  // First make-up day on or after day_
+    ClassConflictIndex::Meetings::const_iterator meeting_;
+    ClassConflictIndex::Meetings::const_iterator meetingsEnd_;
+};
+
+#endif // TERM_CALENDAR_H
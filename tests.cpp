@@ -0,0 +1,477 @@
+// --- ISKAALAMAN behaviour checks ---
+// Links libiskaalaman_core and checks the parts of it that are easy to get
+// subtly wrong: journal replay after a crash, CSV quoting, integer parsing
+// limits, bulk class import overlaps, task removal, the flashcard stores, date parsing and the timetable solver's ranking. Run with
+// `make test`; it runs in test_data/ (removed first), where the stores read
+// and write their usual file names.
+// Prints one line per failed check and exits non-zero if there was any.
+#include "journal.h"
+#include "line_reader.h"
+#include "csv_reader.h"
+#include "class_import.h"
+#include "civil_date.h"
+#include "timetable_solver.h"
+#include "file_handler.h"
+#include "scheduler_core.h"
+#include "subject_registry.h"
+#include "study_core.h"
+#include "flashcard_binary.h"
+#include "mapped_file.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/stat.h> // For mkdir
+    #include <unistd.h>   // For chdir
+#endif
+
+static int checks = 0;
+static int failures = 0;
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+static void check(bool passed, const char* expression, const char* file, int line) {
+    ++checks;
+    if (!passed) {
+        ++failures;
+        std::cerr << file << ":" << line << ": check failed: " << expression << "\n";
+    }
+}
+
+static const std::string TEST_DIR = "test_data";
+
+static void write_text(const std::string& path, const std::string& contents) {
+    std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+    out << contents;
+}
+
+static JournalRecord make_record(const std::string& op, const std::string& field) {
+    JournalRecord record;
+    record.op = op;
+    record.fields.push_back(field);
+    return record;
+}
+
+// --- Journal ---
+
+static void test_journal_torn_tail() {
+    const std::string path = "torn.log";
+    const uint64_t snapshot = snapshot_id("v1", 2);
+    truncate_journal(path, snapshot);
+    CHECK(append_journal_record(path, make_record("ADD", "first")));
+    CHECK(append_journal_record(path, make_record("ADD", "multi\nline")));
+
+    // An append cut short by a crash: header and length written, bytes missing
+    std::ofstream(path.c_str(), std::ios::binary | std::ios::app) << "@ADD 1\n10\nhalf";
+
+    std::vector<std::string> seen;
+    size_t applied = replay_journal(path, snapshot, [&](const JournalRecord& record) {
+        seen.push_back(record.fields.empty() ? std::string() : record.fields[0]);
+        return true;
+    });
+    CHECK(applied == 2);
+    CHECK(seen.size() == 2 && seen[0] == "first" && seen[1] == "multi\nline");
+    CHECK(journal_needs_compaction(path));
+
+    // A clean journal replays fully and doesn't ask to be compacted
+    truncate_journal(path, snapshot);
+    CHECK(append_journal_record(path, make_record("ADD", "only")));
+    CHECK(replay_journal(path, snapshot, [](const JournalRecord&) { return true; }) == 1);
+    CHECK(!journal_needs_compaction(path));
+}
+
+static void test_journal_stale_base() {
+    // Left behind when a save renamed its snapshot in but died before emptying the journal
+    const std::string path = "stale.log";
+    truncate_journal(path, snapshot_id("old", 3));
+    CHECK(append_journal_record(path, make_record("ADD", "already saved")));
+    size_t applied = replay_journal(path, snapshot_id("new", 3), [](const JournalRecord&) { return true; });
+    CHECK(applied == 0);
+    CHECK(journal_needs_compaction(path));
+}
+
+// --- CSV ---
+
+static void test_csv_quoting() {
+    const std::string text =
+        "plain,\"with, comma\",\"say \"\"hi\"\"\"\r\n"
+        "\n"
+        "\"two\nlines\",,last\n"
+        "\"\",x\n"
+        "end";
+    CsvReader reader(text.data(), text.size());
+    std::vector<std::string> fields;
+
+    CHECK(reader.next_record(fields));
+    CHECK(reader.line_number() == 1);
+    CHECK(fields.size() == 3 && fields[0] == "plain" && fields[1] == "with, comma" && fields[2] == "say \"hi\"");
+
+    CHECK(reader.next_record(fields)); // The blank line is skipped
+    CHECK(reader.line_number() == 3);
+    CHECK(fields.size() == 3 && fields[0] == "two\nlines" && fields[1].empty() && fields[2] == "last");
+
+    CHECK(reader.next_record(fields));
+    CHECK(reader.line_number() == 5);
+    CHECK(fields.size() == 2 && fields[0].empty() && fields[1] == "x");
+
+    CHECK(reader.next_record(fields)); // No line break after the last record
+    CHECK(fields.size() == 1 && fields[0] == "end");
+    CHECK(!reader.next_record(fields));
+
+    // Quoting on the way out reads back to the same fields
+    std::string line;
+    append_csv_field(line, std::string("a,b"));
+    line += ',';
+    append_csv_field(line, std::string("q\"\nr"));
+    line += ',';
+    append_csv_field(line, std::string("bare"));
+    CHECK(line == "\"a,b\",\"q\"\"\nr\",bare");
+    CsvReader round_trip(line.data(), line.size());
+    CHECK(round_trip.next_record(fields));
+    CHECK(fields.size() == 3 && fields[0] == "a,b" && fields[1] == "q\"\nr" && fields[2] == "bare");
+}
+
+// --- Line reader ---
+
+static bool parses_to(const std::string& text, long long expected) {
+    long long value = 0;
+    return parse_leading_int(text.data(), text.size(), value) && value == expected;
+}
+
+static void test_parse_leading_int() {
+    long long value = 0;
+    CHECK(parses_to("  42 rest", 42));
+    CHECK(parses_to("+7", 7));
+    CHECK(parses_to("-0", 0));
+    CHECK(parses_to("9223372036854775807", std::numeric_limits<long long>::max()));
+    CHECK(!parse_leading_int("9223372036854775808", 19, value));
+    CHECK(parses_to("-9223372036854775808", std::numeric_limits<long long>::min()));
+    CHECK(!parse_leading_int("-9223372036854775809", 20, value));
+    CHECK(!parse_leading_int("-", 1, value));
+}
+
+// --- Class import ---
+
+static bool has_issue(const ClassImportReport& report, size_t line, const std::string& text) {
+    for (size_t i = 0; i < report.issues.size(); ++i) {
+        if (report.issues[i].line == line && report.issues[i].message.find(text) != std::string::npos) return true;
+    }
+    return false;
+}
+
+static void test_import_overlaps() {
+    std::vector<ClassDetails> saved;
+    saved.swap(classSchedule);
+
+    ClassDetails existing;
+    existing.subject = "Math";
+    existing.dayMask = 1u << 1; // Mon
+    existing.startMinutes = 9 * 60;
+    existing.endMinutes = 10 * 60 + 30;
+    classSchedule.push_back(existing);
+
+    const std::string path = "import.csv";
+    write_text(path,
+        "subject,days,start,end,venue\n"
+        "Physics,\"Mon,Wed\",10:00 AM,11:00 AM,Lab\n"  // 2: overlaps Math on Monday
+        "Chem,Tue,01:00 PM,02:30 PM,\n"                  // 3: overlaps line 4
+        "Bio,Tue,02:00 PM,03:00 PM\n"                    // 4: overlaps line 3
+        "Art,Thu,08:00 AM,09:00 AM\n"                    // 5: fine
+        "History,Fri,10:00 AM,11:00 AM\n"                // 6: touches line 7 end to start
+        "Music,Fri,11:00 AM,12:00 PM\n"                  // 7: fine
+        "Bad,Fri,noon,01:00 PM\n");                      // 8: unparsable time
+
+    ClassImportReport report;
+    CHECK(import_classes_csv(path, report, false));
+    CHECK(report.rowsRead == 7);
+    CHECK(report.imported == 3);
+    CHECK(report.rejected == 4);
+    CHECK(has_issue(report, 2, "overlaps existing class Math"));
+    CHECK(has_issue(report, 3, "overlaps line 4"));
+    CHECK(has_issue(report, 4, "overlaps line 3"));
+    CHECK(has_issue(report, 8, "times must look like"));
+    CHECK(!has_issue(report, 5, "") && !has_issue(report, 6, "") && !has_issue(report, 7, ""));
+    CHECK(classSchedule.size() == 1); // Dry run
+
+    ClassImportReport missing;
+    CHECK(!import_classes_csv("no_such_file.csv", missing, false));
+
+    classSchedule.swap(saved);
+}
+
+// --- Tasks ---
+
+static TaskDetails make_task(const std::string& name, int urgency) {
+    TaskDetails task;
+    task.name = tasksArena.copy(name);
+    task.subject = "Math";
+    task.deadline = CivilDate::parse("2030-01-01");
+    task.urgency = urgency;
+    return task;
+}
+
+static void test_task_removal() {
+    clearTasks();
+    rebuildTaskPriorityIndex();
+    rebuild_task_subjects();
+    for (int i = 0; i < 6; ++i) appendTask(make_task("t" + std::to_string(i), 1 + i % 3));
+
+    // Removing keeps every other task at its index, so held indices stay valid
+    removeTaskAt(1);
+    removeTaskAt(4);
+    CHECK(taskCount() == 4 && tasks.size() == 6);
+    CHECK(tasks[2].name.str() == "t2" && tasks[5].name.str() == "t5");
+    std::vector<size_t> pending = taskPriorityIndex.pendingByPriority();
+    CHECK(pending.size() == 4 && std::find(pending.begin(), pending.end(), size_t(1)) == pending.end());
+    std::vector<size_t> math = subject_registry.tasks_for("Math");
+    std::sort(math.begin(), math.end());
+    CHECK(math.size() == 4 && math[0] == 0 && math[1] == 2 && math[2] == 3 && math[3] == 5);
+    completeTaskAt(1); // A removed slot stays out of the index
+    CHECK(taskPriorityIndex.pendingByPriority().size() == 4);
+
+    // Once removed slots outnumber live tasks they are squeezed out, order kept
+    removeTaskAt(0);
+    removeTaskAt(3);
+    CHECK(taskCount() == 2 && tasks.size() == 2);
+    CHECK(tasks[0].name.str() == "t2" && tasks[1].name.str() == "t5");
+    CHECK(taskPriorityIndex.pendingByPriority().size() == 2);
+    CHECK(subject_registry.tasks_for("Math").size() == 2);
+
+    clearTasks();
+    rebuildTaskPriorityIndex();
+    rebuild_task_subjects();
+}
+
+// --- Flashcards ---
+
+static Deck make_deck(const std::string& title, const std::string& question) {
+    Deck deck;
+    deck.subject = "Bio";
+    deck.title = title;
+    deck.timestamp = "2030-01-01 09:00:00";
+    Card card;
+    card.question = question;
+    card.answer = "yes";
+    deck.cards.push_back(card);
+    return deck;
+}
+
+static void test_flashcard_binary() {
+    flashcard_decks.clear();
+    flashcard_decks.push_back(make_deck("Cells", "Has a nucleus?"));
+    flashcard_decks.push_back(make_deck("Genes", "Made of DNA?"));
+    CHECK(save_flashcards_to_file());
+    CHECK(convert_flashcards_text_to_binary(FLASHCARDS_FILE, FLASHCARDS_BINARY_FILE));
+
+    // Decks read from the binary store load clean, with the text ranges a parse
+    // of flashcards.dat gives, so the next save copies their text
+    MappedFile text;
+    CHECK(text.open(FLASHCARDS_FILE));
+    std::vector<Deck> from_binary, from_text;
+    CHECK(read_flashcards_binary_for(FLASHCARDS_BINARY_FILE, snapshot_id(text.data(), text.size()), from_binary));
+    CHECK(read_flashcards_text(text.data(), text.size(), from_text));
+    CHECK(from_binary.size() == 2 && from_text.size() == 2);
+    for (size_t i = 0; i < from_binary.size() && i < from_text.size(); ++i) {
+        CHECK(!from_binary[i].dirty && from_binary[i].cards.size() == 1);
+        CHECK(from_binary[i].snapshot_offset == from_text[i].snapshot_offset &&
+              from_binary[i].snapshot_length == from_text[i].snapshot_length);
+    }
+    text.close();
+    CHECK(!read_flashcards_binary_for(FLASHCARDS_BINARY_FILE, snapshot_id("other", 5), from_binary));
+    load_flashcards_from_file();
+    CHECK(flashcard_decks.size() == 2 && !flashcard_decks[0].dirty && !flashcard_decks[1].dirty);
+
+    // A card added since the store was built is journaled; rebuilding the text keeps it
+    Card added;
+    added.question = "Splits by mitosis?";
+    added.answer = "yes";
+    flashcard_decks[0].cards.push_back(added);
+    flashcard_decks[0].dirty = true;
+    journal_card_added(0, added);
+    std::remove(FLASHCARDS_FILE.c_str());
+    CHECK(rebuild_flashcards_text_from_binary());
+    load_flashcards_from_file();
+    CHECK(flashcard_decks.size() == 2 && flashcard_decks[0].cards.size() == 2);
+    CHECK(flashcard_decks.size() == 2 && !flashcard_decks[0].dirty); // From the rebuilt binary
+
+    // Saving replaces the text the binary mirrors, so the binary goes
+    flashcard_decks[1].dirty = true;
+    CHECK(save_flashcards_to_file());
+    std::vector<Deck> stale;
+    uint64_t mirrored_id = 0;
+    CHECK(!read_flashcards_binary(FLASHCARDS_BINARY_FILE, stale, mirrored_id));
+    flashcard_decks.clear();
+}
+
+// --- Dates ---
+
+static void test_civil_date() {
+    CHECK(CivilDate::parse("1970-01-01").dayNumber == 0);
+    CHECK(CivilDate::parse("2000-03-01").dayNumber - CivilDate::parse("2000-02-28").dayNumber == 2);
+    CHECK(CivilDate::parse("1900-03-01").dayNumber - CivilDate::parse("1900-02-28").dayNumber == 1);
+    CHECK(CivilDate::parse("2024-02-29").isValid());
+    CHECK(CivilDate::parse("1970-01-01").weekday() == 4); // Thursday
+
+    // Every day of two centuries formats back to the text it was parsed from
+    bool round_trips = true;
+    for (int day = CivilDate::parse("1899-12-25").dayNumber; day <= CivilDate::parse("2101-01-05").dayNumber; ++day) {
+        std::string text = CivilDate(day).toString();
+        int year = 0, month = 0, dom = 0;
+        CivilDate(day).toYmd(year, month, dom);
+        if (CivilDate::parse(text).dayNumber != day || CivilDate::fromYmd(year, month, dom).dayNumber != day) {
+            round_trips = false;
+            break;
+        }
+    }
+    CHECK(round_trips);
+    CHECK(CivilDate::parse("0000-01-01").toString() == "0000-01-01");
+    CHECK(CivilDate::parse("9999-12-31").toString() == "9999-12-31");
+
+    const char* invalid[] = {
+        "2023-02-29", "1900-02-29", "2024-04-31", "2024-13-01", "2024-00-10", "2024-01-00",
+        "2024-1-01", "2024/01/01", " 2024-01-01", "2024-01-01 ", "2024-01-0x", "", "abcd-ef-gh"
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); ++i) {
+        if (CivilDate::parse(invalid[i]).isValid()) {
+            std::cerr << "  accepted \"" << invalid[i] << "\"\n";
+            CHECK(false);
+        }
+    }
+    CHECK(!CivilDate::fromYmd(10000, 1, 1).isValid());
+    CHECK(!CivilDate::fromYmd(-1, 1, 1).isValid());
+    CHECK(CivilDate().toString() == "----------");
+}
+
+// --- Timetable solver ---
+
+static bool sections_clash(const ClassDetails& a, const ClassDetails& b) {
+    return (a.dayMask & b.dayMask) && a.startMinutes < b.endMinutes && b.startMinutes < a.endMinutes;
+}
+
+// The penalty of one combination, worked out minute by minute
+static int brute_force_penalty(const std::vector<const ClassDetails*>& chosen, const TimetablePreferences& preferences) {
+    std::vector<std::vector<char> > busy(7, std::vector<char>(24 * 60, 0));
+    int early = 0;
+    unsigned char used = 0;
+    for (size_t i = 0; i < chosen.size(); ++i) {
+        for (int d = 0; d < 7; ++d) {
+            if (!(chosen[i]->dayMask & (1u << d))) continue;
+            used |= static_cast<unsigned char>(1u << d);
+            for (int m = chosen[i]->startMinutes; m < chosen[i]->endMinutes; ++m) busy[d][m] = 1;
+            early += std::max(0, std::min(chosen[i]->endMinutes, preferences.earliestStartMinutes) - chosen[i]->startMinutes);
+        }
+    }
+    int idle = 0;
+    int days = 0;
+    for (int d = 0; d < 7; ++d) {
+        int first = -1, last = -1, taken = 0;
+        for (int m = 0; m < 24 * 60; ++m) {
+            if (!busy[d][m]) continue;
+            if (first < 0) first = m;
+            last = m;
+            ++taken;
+        }
+        if (first >= 0) idle += last - first + 1 - taken;
+        if (used & (1u << d)) ++days;
+    }
+    return early * preferences.earlyMinuteWeight + idle * preferences.idleMinuteWeight + days * preferences.dayWeight;
+}
+
+static ClassDetails make_section(unsigned char dayMask, int start, int end) {
+    ClassDetails cls;
+    cls.subject = "S";
+    cls.dayMask = dayMask;
+    cls.startMinutes = start;
+    cls.endMinutes = end;
+    return cls;
+}
+
+static void test_solver_optimal() {
+    // Small enough to try every combination; a fixed Monday class blocks some sections
+    std::vector<TimetableSubject> subjects(4);
+    unsigned seed = 12345;
+    for (size_t s = 0; s < subjects.size(); ++s) {
+        subjects[s].subject = "S" + std::to_string(s);
+        for (int k = 0; k < 6; ++k) {
+            seed = seed * 1103515245u + 12345u;
+            unsigned char days = static_cast<unsigned char>(1 + (seed >> 8) % 62);
+            int start = 7 * 60 + static_cast<int>((seed >> 16) % 18) * 30;
+            subjects[s].sections.push_back(make_section(days, start, start + 60 + static_cast<int>((seed >> 4) % 3) * 30));
+        }
+    }
+    std::vector<ClassDetails> fixed(1, make_section(1u << 1, 12 * 60, 13 * 60));
+
+    TimetablePreferences preferences;
+    preferences.maxResults = 5;
+
+    std::vector<std::pair<int, std::vector<size_t> > > expected;
+    std::vector<size_t> pick(subjects.size(), 0);
+    for (;;) {
+        std::vector<const ClassDetails*> chosen;
+        bool valid = true;
+        for (size_t s = 0; s < subjects.size(); ++s) chosen.push_back(&subjects[s].sections[pick[s]]);
+        for (size_t a = 0; a < chosen.size(); ++a) {
+            for (size_t b = a + 1; b < chosen.size(); ++b) valid = valid && !sections_clash(*chosen[a], *chosen[b]);
+            valid = valid && !sections_clash(*chosen[a], fixed[0]);
+        }
+        if (valid) {
+            chosen.push_back(&fixed[0]);
+            expected.push_back(std::make_pair(brute_force_penalty(chosen, preferences), pick));
+        }
+        size_t s = 0;
+        while (s < pick.size() && ++pick[s] == subjects[s].sections.size()) pick[s++] = 0;
+        if (s == pick.size()) break;
+    }
+    std::sort(expected.begin(), expected.end());
+    CHECK(expected.size() >= preferences.maxResults);
+    if (expected.size() > preferences.maxResults) expected.resize(preferences.maxResults);
+
+    const unsigned thread_counts[] = {1, 4};
+    for (size_t t = 0; t < 2; ++t) {
+        preferences.threads = thread_counts[t];
+        TimetableSolveStats stats;
+        std::vector<TimetableSolution> solutions = solveTimetable(subjects, fixed, preferences, &stats);
+        CHECK(stats.exhaustive);
+        CHECK(solutions.size() == expected.size());
+        for (size_t i = 0; i < solutions.size() && i < expected.size(); ++i) {
+            CHECK(solutions[i].penalty == expected[i].first);
+            CHECK(solutions[i].sections == expected[i].second); // Ties are broken by section indices
+            CHECK(solutions[i].penalty == solutions[i].earlyMinutes * preferences.earlyMinuteWeight +
+                                          solutions[i].idleMinutes * preferences.idleMinuteWeight +
+                                          solutions[i].days * preferences.dayWeight);
+        }
+    }
+
+    // No conflict-free combination at all
+    std::vector<TimetableSubject> clashing(2);
+    clashing[0].sections.push_back(make_section(1u << 3, 9 * 60, 10 * 60));
+    clashing[1].sections.push_back(make_section(1u << 3, 9 * 60 + 30, 11 * 60));
+    CHECK(solveTimetable(clashing, std::vector<ClassDetails>(), preferences).empty());
+}
+
+int main() {
+#if defined(__unix__) || defined(__APPLE__)
+    ::mkdir(TEST_DIR.c_str(), 0755); // Fine if it already exists
+    if (::chdir(TEST_DIR.c_str()) != 0) {
+        std::cerr << "Error: Cannot enter " << TEST_DIR << "." << std::endl;
+        return 1;
+    }
+#endif
+
+    test_journal_torn_tail();
+    test_journal_stale_base();
+    test_csv_quoting();
+    test_parse_leading_int();
+    test_import_overlaps();
+    test_task_removal();
+    test_flashcard_binary();
+    test_civil_date();
+    test_solver_optimal();
+
+    std::cout << checks - failures << "/" << checks << " checks passed\n";
+    return failures == 0 ? 0 : 1;
+}
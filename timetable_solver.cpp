@@ -0,0 +1,660 @@
+#include "timetable_solver.h"
+#include "mapped_file.h" // The CSV is mapped, not streamed through iostreams
+#include "csv_reader.h"  // For CsvReader
+#include <algorithm>     // For std::sort, std::min, std::max
+#include <atomic>
+#include <bitset>        // For counting set bits
+#include <condition_variable>
+#include <cctype>        // For ::tolower
+#include <climits>       // For INT_MAX
+#include <cstdint>       // For uint64_t
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <map>
+#include <tuple>
+
+static const int DAY_WORDS = 23; // 1440 minutes in 64-bit words; no word spans two days
+static const int WEEK_WORDS = 7 * DAY_WORDS;
+static const unsigned long long NODE_FLUSH_INTERVAL = 1024; // Nodes counted locally between updates of the shared count
+static const size_t EXHAUSTED_CACHE_LIMIT = 1 << 16;        // Per thread; the cache starts over when it fills
+
+static int countBits(uint64_t bits) {
+    return static_cast<int>(std::bitset<64>(bits).count());
+}
+
+static int lowestBit(uint64_t bits) { // bits != 0
+    return countBits((bits & (~bits + 1)) - 1);
+}
+
+static int highestBit(uint64_t bits) { // bits != 0
+    int position = 0;
+    for (int shift = 32; shift > 0; shift >>= 1) {
+        if (bits >> shift) {
+            bits >>= shift;
+            position += shift;
+        }
+    }
+    return position;
+}
+
+static bool isSchedulable(const ClassDetails& cls) {
+    return cls.dayMask != 0 && cls.startMinutes >= 0 && cls.endMinutes > cls.startMinutes && cls.endMinutes <= 24 * 60;
+}
+
+// ORs the minutes `cls` meets into a week of per-day minute bitsets.
+static void markClassMinutes(const ClassDetails& cls, std::vector<uint64_t>& week) {
+    for (int day = 0; day < 7; ++day) {
+        if (!(cls.dayMask & (1u << day))) continue;
+        for (int minute = cls.startMinutes; minute < cls.endMinutes;) {
+            int bit = minute % 64;
+            int run = std::min(64 - bit, cls.endMinutes - minute);
+            uint64_t bits = (run == 64 ? ~uint64_t(0) : ((uint64_t(1) << run) - 1)) << bit;
+            week[day * DAY_WORDS + minute / 64] |= bits;
+            minute += run;
+        }
+    }
+}
+
+// Writes the free minutes between the first and last busy minute of one day
+// into `gaps` (DAY_WORDS words) and returns how many there are.
+static int dayGaps(const uint64_t* busy, uint64_t* gaps) {
+    int first = -1, last = -1;
+    for (int w = 0; w < DAY_WORDS; ++w) {
+        if (!busy[w]) continue;
+        if (first == -1) first = w * 64 + lowestBit(busy[w]);
+        last = w * 64 + highestBit(busy[w]);
+    }
+    int idle = 0;
+    for (int w = 0; w < DAY_WORDS; ++w) {
+        int low = std::max(first, w * 64) - w * 64;
+        int high = std::min(last, w * 64 + 63) - w * 64;
+        if (first == -1 || low > high) {
+            gaps[w] = 0;
+            continue;
+        }
+        uint64_t span = (high - low == 63 ? ~uint64_t(0) : ((uint64_t(1) << (high - low + 1)) - 1)) << low;
+        gaps[w] = span & ~busy[w];
+        idle += countBits(gaps[w]);
+    }
+    return idle;
+}
+
+// Class minutes before `earliest`, summed over the days the class meets.
+static int earlyMinutesOf(const ClassDetails& cls, int earliest) {
+    int before = std::min(cls.endMinutes, earliest) - cls.startMinutes;
+    return before > 0 ? before * countBits(cls.dayMask) : 0;
+}
+
+// --- Search ---
+namespace {
+
+struct SearchState {
+    std::vector<uint64_t> domains; // Every subject's remaining sections; bit b of subject s = section firstSection[s] + b
+    std::vector<int> chosen;       // Per subject: the chosen section, or -1 while open
+    std::vector<uint64_t> minutes; // WEEK_WORDS: busy minutes per day, fixed classes included
+    size_t assigned;
+    unsigned char days;            // The exact days every combination below this state meets on
+    unsigned char daysUsed;        // Fixed classes included
+    int earlyMinutes;              // Fixed classes included
+};
+
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<SearchState> tasks; // The owner pushes and pops at the back; thieves take the front
+};
+
+// Everything the threads share. The section tables are read-only once built.
+struct SharedSearch {
+    const TimetablePreferences& preferences;
+    size_t subjectCount;
+    std::vector<size_t> firstSection;   // Per subject, plus one past the end
+    std::vector<size_t> firstWord;      // Per subject, plus one past the end: its words in SearchState::domains
+    std::vector<size_t> sectionSubject; // Per section
+    std::vector<size_t> sectionOriginal; // Per section: index in TimetableSubject::sections
+    std::vector<const ClassDetails*> sectionClass;
+    std::vector<uint32_t> sectionSlot;  // Per section: sections with the same days and times share a slot
+    std::vector<int> sectionEarly;
+    std::vector<size_t> maskBegin;      // Per section, plus one past the end: its non-zero minute words
+    std::vector<int> maskWord;          // Word index in a week of minute bitsets
+    std::vector<uint64_t> maskBits;
+    std::vector<uint64_t> compatible;   // sectionCount rows of domainWords: sections each section can be taken with
+    std::vector<uint64_t> within;       // 128 rows of domainWords: sections meeting only on days in mask D
+    size_t domainWords;
+
+    std::mutex resultsMutex;
+    std::vector<TimetableSolution> best; // Sorted, at most maxResults
+    std::atomic<int> threshold;          // Worst kept penalty once `best` is full; branches whose bound exceeds it are cut
+
+    std::vector<WorkQueue> queues;
+    std::atomic<long> pendingTasks;      // Queued or running; zero means the search is over
+    std::atomic<long> queuedTasks;       // Waiting in some queue
+    std::atomic<int> idleThreads;
+    std::mutex idleMutex;                // With workReady, parks threads that found nothing to take
+    std::condition_variable workReady;   // Signalled when a task is queued or the search ends
+    std::atomic<unsigned long long> nodes;
+    std::atomic<bool> stop;
+
+    SharedSearch(const TimetablePreferences& prefs, unsigned threadCount)
+        : preferences(prefs), subjectCount(0), domainWords(0), threshold(INT_MAX), queues(threadCount),
+          pendingTasks(0), queuedTasks(0), idleThreads(0), nodes(0), stop(false) {}
+};
+
+static bool solutionBefore(const TimetableSolution& a, const TimetableSolution& b) {
+    return a.penalty != b.penalty ? a.penalty < b.penalty : a.sections < b.sections;
+}
+
+class SearchWorker {
+public:
+    SearchWorker(SharedSearch& shared, size_t id)
+        : shared_(shared), id_(id), states_(shared.subjectCount + 1), candidates_(shared.subjectCount + 1),
+          gaps_(WEEK_WORDS), fits_(shared.domainWords), kept_(0), localNodes_(0), pruned_(0), complete_(0), steals_(0) {}
+
+    void run();
+
+    unsigned long long pruned() const { return pruned_; }
+    unsigned long long complete() const { return complete_; }
+    unsigned long long steals() const { return steals_; }
+
+private:
+    bool takeTask(SearchState& task);
+    void search(size_t depth);
+    bool choose(SearchState& state, size_t section) const; // False if an open subject runs out of sections
+    bool fitsWithin(const SearchState& state, int days);
+    void recordComplete(const SearchState& state);
+    void countNode();
+    const std::string& stateKey(const SearchState& state);
+
+    SharedSearch& shared_;
+    size_t id_;
+    std::vector<SearchState> states_;                        // One per depth (= subjects assigned), reused
+    std::vector<std::vector<std::pair<int, size_t> > > candidates_; // Per depth: (cost, section) in the order tried
+    std::vector<uint64_t> gaps_;                             // Scratch: free minutes inside each day's span
+    std::vector<uint64_t> fits_;                             // Scratch: domains narrowed by fitsWithin
+    std::unordered_set<std::string> exhausted_;              // stateKey of subtrees searched without keeping anything
+    std::string key_;                                        // Scratch for stateKey
+    std::vector<uint32_t> slots_;
+    unsigned long long kept_;                                // Combinations this thread put into the best kept
+    unsigned long long localNodes_;
+    unsigned long long pruned_;
+    unsigned long long complete_;
+    unsigned long long steals_;
+};
+
+void SearchWorker::run() {
+    SearchState task;
+    while (true) {
+        if (takeTask(task)) {
+            size_t depth = task.assigned;
+            std::swap(states_[depth], task);
+            search(depth);
+            if (--shared_.pendingTasks == 0) {
+                std::lock_guard<std::mutex> lock(shared_.idleMutex);
+                shared_.workReady.notify_all(); // Wake everyone to finish
+            }
+            continue;
+        }
+        // Nothing to take: sleep until a branch is queued (busy threads hand
+        // branches over while idleThreads > 0) or the last task finishes.
+        std::unique_lock<std::mutex> lock(shared_.idleMutex);
+        if (shared_.pendingTasks.load() == 0) break;
+        shared_.idleThreads++;
+        shared_.workReady.wait(lock, [this] {
+            return shared_.queuedTasks.load() > 0 || shared_.pendingTasks.load() == 0;
+        });
+        shared_.idleThreads--;
+    }
+    shared_.nodes += localNodes_ % NODE_FLUSH_INTERVAL;
+}
+
+bool SearchWorker::takeTask(SearchState& task) {
+    {
+        WorkQueue& own = shared_.queues[id_];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            std::swap(task, own.tasks.back());
+            own.tasks.pop_back();
+            shared_.queuedTasks--;
+            return true;
+        }
+    }
+    for (size_t k = 1; k < shared_.queues.size(); ++k) {
+        WorkQueue& victim = shared_.queues[(id_ + k) % shared_.queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            std::swap(task, victim.tasks.front()); // The oldest branch is nearest the root, so the largest
+            victim.tasks.pop_front();
+            shared_.queuedTasks--;
+            steals_++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SearchWorker::countNode() {
+    if (++localNodes_ % NODE_FLUSH_INTERVAL != 0) return;
+    unsigned long long total = shared_.nodes += NODE_FLUSH_INTERVAL;
+    if (shared_.preferences.nodeLimit != 0 && total >= shared_.preferences.nodeLimit) shared_.stop = true;
+}
+
+bool SearchWorker::choose(SearchState& state, size_t section) const {
+    size_t subject = shared_.sectionSubject[section];
+    state.chosen[subject] = static_cast<int>(section);
+    state.assigned++;
+    state.daysUsed |= shared_.sectionClass[section]->dayMask;
+    state.earlyMinutes += shared_.sectionEarly[section];
+    for (size_t m = shared_.maskBegin[section]; m < shared_.maskBegin[section + 1]; ++m) {
+        state.minutes[shared_.maskWord[m]] |= shared_.maskBits[m];
+    }
+    const uint64_t* row = &shared_.compatible[section * shared_.domainWords];
+    for (size_t other = 0; other < shared_.subjectCount; ++other) {
+        if (state.chosen[other] != -1) continue;
+        uint64_t any = 0;
+        for (size_t w = shared_.firstWord[other]; w < shared_.firstWord[other + 1]; ++w) {
+            state.domains[w] &= row[w];
+            any |= state.domains[w];
+        }
+        if (!any) return false;
+    }
+    return true;
+}
+
+// Whether the open subjects could still all be placed using only the days in
+// `days`: each keeps the sections meeting within them, then a section is dropped
+// while some other open subject has no section left that it can be taken with,
+// until nothing changes (arc consistency). False means no combination below
+// this node fits in those days; true is not a promise that one does.
+bool SearchWorker::fitsWithin(const SearchState& state, int days) {
+    const uint64_t* inside = &shared_.within[days * shared_.domainWords];
+    for (size_t subject = 0; subject < shared_.subjectCount; ++subject) {
+        if (state.chosen[subject] != -1) continue;
+        uint64_t any = 0;
+        for (size_t w = shared_.firstWord[subject]; w < shared_.firstWord[subject + 1]; ++w) {
+            fits_[w] = state.domains[w] & inside[w];
+            any |= fits_[w];
+        }
+        if (!any) return false;
+    }
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (size_t subject = 0; subject < shared_.subjectCount; ++subject) {
+            if (state.chosen[subject] != -1) continue;
+            uint64_t any = 0;
+            for (size_t w = shared_.firstWord[subject]; w < shared_.firstWord[subject + 1]; ++w) {
+                for (uint64_t bits = fits_[w]; bits; bits &= bits - 1) {
+                    size_t section = shared_.firstSection[subject] + (w - shared_.firstWord[subject]) * 64 + lowestBit(bits);
+                    const uint64_t* row = &shared_.compatible[section * shared_.domainWords];
+                    for (size_t other = 0; other < shared_.subjectCount; ++other) {
+                        if (other == subject || state.chosen[other] != -1) continue;
+                        uint64_t support = 0;
+                        for (size_t v = shared_.firstWord[other]; v < shared_.firstWord[other + 1] && !support; ++v) {
+                            support = row[v] & fits_[v];
+                        }
+                        if (!support) {
+                            fits_[w] &= ~(bits & (~bits + 1));
+                            changed = true;
+                            break;
+                        }
+                    }
+                }
+                any |= fits_[w];
+            }
+            if (!any) return false;
+        }
+    }
+    return true;
+}
+
+// What the rest of the search depends on: the target days, which subjects are
+// assigned and the slots they took. Two states with the same key have the same
+// busy minutes, so the same open sections and the same penalty for every way
+// of completing them; only which section of a slot was picked differs.
+const std::string& SearchWorker::stateKey(const SearchState& state) {
+    key_.assign(1, static_cast<char>(state.days));
+    slots_.clear();
+    for (size_t subject = 0; subject < shared_.subjectCount; ++subject) {
+        if (state.chosen[subject] == -1) continue;
+        key_.append(reinterpret_cast<const char*>(&subject), sizeof(subject));
+        slots_.push_back(shared_.sectionSlot[state.chosen[subject]]);
+    }
+    std::sort(slots_.begin(), slots_.end());
+    key_.append(reinterpret_cast<const char*>(slots_.data()), slots_.size() * sizeof(uint32_t));
+    return key_;
+}
+
+void SearchWorker::search(size_t depth) {
+    const TimetablePreferences& prefs = shared_.preferences;
+    SearchState& state = states_[depth];
+    countNode();
+    if (shared_.stop.load(std::memory_order_relaxed)) return;
+    if (state.assigned == shared_.subjectCount) {
+        recordComplete(state);
+        return;
+    }
+
+    // Branch on the open subject with the fewest sections left. On the way,
+    // bound the penalty of anything below this node:
+    // - each open subject adds at least its cheapest early minutes;
+    // - the days used end up exactly state.days, so every one of them must
+    //   still be reachable by some open subject's sections;
+    // - a day's idle time only shrinks by what later sections fill, and each
+    //   open subject fills at most as much of the current gaps as its best section.
+    int idle[7];
+    int canFill[7] = {0, 0, 0, 0, 0, 0, 0};
+    for (int day = 0; day < 7; ++day) {
+        idle[day] = dayGaps(&state.minutes[day * DAY_WORDS], &gaps_[day * DAY_WORDS]);
+    }
+    size_t branchSubject = 0;
+    int fewest = INT_MAX;
+    int earlyBound = 0;
+    unsigned char reachable = state.daysUsed;
+    for (size_t subject = 0; subject < shared_.subjectCount; ++subject) {
+        if (state.chosen[subject] != -1) continue;
+        int count = 0;
+        int leastEarly = INT_MAX;
+        int mostFilled[7] = {0, 0, 0, 0, 0, 0, 0};
+        for (size_t w = shared_.firstWord[subject]; w < shared_.firstWord[subject + 1]; ++w) {
+            uint64_t bits = state.domains[w];
+            count += countBits(bits);
+            for (; bits; bits &= bits - 1) {
+                size_t section = shared_.firstSection[subject] + (w - shared_.firstWord[subject]) * 64 + lowestBit(bits);
+                leastEarly = std::min(leastEarly, shared_.sectionEarly[section]);
+                reachable |= shared_.sectionClass[section]->dayMask;
+                int filled[7] = {0, 0, 0, 0, 0, 0, 0};
+                for (size_t m = shared_.maskBegin[section]; m < shared_.maskBegin[section + 1]; ++m) {
+                    filled[shared_.maskWord[m] / DAY_WORDS] += countBits(shared_.maskBits[m] & gaps_[shared_.maskWord[m]]);
+                }
+                for (int day = 0; day < 7; ++day) mostFilled[day] = std::max(mostFilled[day], filled[day]);
+            }
+        }
+        earlyBound += leastEarly;
+        for (int day = 0; day < 7; ++day) canFill[day] += mostFilled[day];
+        if (count < fewest) {
+            fewest = count;
+            branchSubject = subject;
+        }
+    }
+    int idleBound = 0;
+    for (int day = 0; day < 7; ++day) idleBound += std::max(0, idle[day] - canFill[day]);
+    int bound = (state.earlyMinutes + earlyBound) * prefs.earlyMinuteWeight + idleBound * prefs.idleMinuteWeight +
+                countBits(state.days) * prefs.dayWeight;
+    // Ties are cut too: a branch can at best match the worst combination kept, not displace it.
+    // Forward checking alone misses most dead ends once the days are fixed, so
+    // the open subjects are also checked against each other (fitsWithin).
+    if (bound >= shared_.threshold.load(std::memory_order_relaxed) || reachable != state.days ||
+        !fitsWithin(state, state.days)) {
+        pruned_++;
+        return;
+    }
+    // Assigning the same slots to the same subjects in another order (or with
+    // other sections in those slots) leads to the same subtree. If one such
+    // subtree was searched to the end without keeping anything, every
+    // completion in it was at or above the threshold then, which only falls, so
+    // this one can't keep anything either. (One that kept something is
+    // searched again: its twins are different combinations to report.)
+    if (exhausted_.count(stateKey(state))) {
+        pruned_++;
+        return;
+    }
+    unsigned long long keptBefore = kept_;
+    bool handedOff = false;
+
+    // Try the sections that add the least penalty first, so good combinations
+    // are found early and tighten the threshold for everyone.
+    std::vector<std::pair<int, size_t> >& order = candidates_[depth];
+    order.clear();
+    for (size_t w = shared_.firstWord[branchSubject]; w < shared_.firstWord[branchSubject + 1]; ++w) {
+        for (uint64_t bits = state.domains[w]; bits; bits &= bits - 1) {
+            size_t section = shared_.firstSection[branchSubject] + (w - shared_.firstWord[branchSubject]) * 64 + lowestBit(bits);
+            int cost = shared_.sectionEarly[section] * prefs.earlyMinuteWeight +
+                       countBits(shared_.sectionClass[section]->dayMask & ~state.daysUsed) * prefs.dayWeight;
+            order.push_back(std::make_pair(cost, section));
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        SearchState& child = states_[depth + 1];
+        child = state;
+        if (!choose(child, order[i].second)) {
+            pruned_++;
+            continue;
+        }
+        if (child.assigned < shared_.subjectCount && shared_.idleThreads.load(std::memory_order_relaxed) > 0) {
+            // Someone is waiting for work: hand this branch over instead of descending into it
+            shared_.pendingTasks++;
+            {
+                WorkQueue& own = shared_.queues[id_];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                own.tasks.push_back(child);
+                shared_.queuedTasks++;
+            }
+            std::lock_guard<std::mutex> lock(shared_.idleMutex);
+            shared_.workReady.notify_one();
+            handedOff = true;
+            continue;
+        }
+        search(depth + 1);
+        if (shared_.stop.load(std::memory_order_relaxed)) return;
+    }
+    if (!handedOff && kept_ == keptBefore) {
+        if (exhausted_.size() >= EXHAUSTED_CACHE_LIMIT) exhausted_.clear();
+        exhausted_.insert(stateKey(state)); // states_[depth] is unchanged by the children
+    }
+}
+
+void SearchWorker::recordComplete(const SearchState& state) {
+    const TimetablePreferences& prefs = shared_.preferences;
+    if (state.daysUsed != state.days) return; // Fits in fewer days; it is scored under those
+    complete_++;
+
+    int idleMinutes = 0;
+    for (int day = 0; day < 7; ++day) {
+        if (state.daysUsed & (1u << day)) idleMinutes += dayGaps(&state.minutes[day * DAY_WORDS], &gaps_[day * DAY_WORDS]);
+    }
+
+    TimetableSolution solution;
+    solution.earlyMinutes = state.earlyMinutes;
+    solution.idleMinutes = idleMinutes;
+    solution.days = countBits(state.daysUsed);
+    solution.penalty = solution.earlyMinutes * prefs.earlyMinuteWeight + solution.idleMinutes * prefs.idleMinuteWeight +
+                       solution.days * prefs.dayWeight;
+    if (solution.penalty >= shared_.threshold.load(std::memory_order_relaxed)) return;
+    solution.sections.resize(shared_.subjectCount);
+    for (size_t subject = 0; subject < shared_.subjectCount; ++subject) {
+        solution.sections[subject] = shared_.sectionOriginal[state.chosen[subject]];
+    }
+
+    kept_++;
+    std::lock_guard<std::mutex> lock(shared_.resultsMutex);
+    std::vector<TimetableSolution>& best = shared_.best;
+    best.insert(std::upper_bound(best.begin(), best.end(), solution, solutionBefore), solution);
+    if (best.size() > prefs.maxResults) best.pop_back();
+    if (best.size() == prefs.maxResults) shared_.threshold = best.back().penalty;
+}
+
+} // namespace
+
+std::vector<TimetableSolution> solveTimetable(const std::vector<TimetableSubject>& subjects,
+                                              const std::vector<ClassDetails>& fixedClasses,
+                                              const TimetablePreferences& preferences,
+                                              TimetableSolveStats* stats) {
+    unsigned threadCount = preferences.threads;
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+    TimetableSolveStats localStats;
+    TimetableSolveStats& result = stats ? *stats : localStats;
+    result = TimetableSolveStats();
+    result.threads = threadCount;
+    if (subjects.empty() || preferences.maxResults == 0) return std::vector<TimetableSolution>();
+
+    SharedSearch shared(preferences, threadCount);
+    shared.subjectCount = subjects.size();
+
+    // 1. Fixed classes become blocked minutes
+    SearchState root;
+    root.assigned = 0;
+    root.days = 0;
+    root.daysUsed = 0;
+    root.earlyMinutes = 0;
+    root.minutes.assign(WEEK_WORDS, 0);
+    for (size_t i = 0; i < fixedClasses.size(); ++i) {
+        if (!isSchedulable(fixedClasses[i])) continue;
+        markClassMinutes(fixedClasses[i], root.minutes);
+        root.daysUsed |= fixedClasses[i].dayMask;
+        root.earlyMinutes += earlyMinutesOf(fixedClasses[i], preferences.earliestStartMinutes);
+    }
+
+    // 2. Number the sections that fit around them, subject by subject, keeping
+    //    the non-zero words of each one's minute bitset
+    std::vector<uint64_t> own(WEEK_WORDS);
+    for (size_t subject = 0; subject < subjects.size(); ++subject) {
+        shared.firstSection.push_back(shared.sectionClass.size());
+        shared.firstWord.push_back(shared.domainWords);
+        const std::vector<ClassDetails>& sections = subjects[subject].sections;
+        for (size_t k = 0; k < sections.size(); ++k) {
+            if (!isSchedulable(sections[k])) continue;
+            std::fill(own.begin(), own.end(), 0);
+            markClassMinutes(sections[k], own);
+            bool blocked = false;
+            for (int w = 0; w < WEEK_WORDS && !blocked; ++w) blocked = (own[w] & root.minutes[w]) != 0;
+            if (blocked) continue;
+            shared.maskBegin.push_back(shared.maskWord.size());
+            for (int w = 0; w < WEEK_WORDS; ++w) {
+                if (!own[w]) continue;
+                shared.maskWord.push_back(w);
+                shared.maskBits.push_back(own[w]);
+            }
+            shared.sectionSubject.push_back(subject);
+            shared.sectionOriginal.push_back(k);
+            shared.sectionClass.push_back(&sections[k]);
+            shared.sectionEarly.push_back(earlyMinutesOf(sections[k], preferences.earliestStartMinutes));
+        }
+        size_t count = shared.sectionClass.size() - shared.firstSection.back();
+        if (count == 0) return std::vector<TimetableSolution>(); // Nothing fits this subject
+        shared.domainWords += (count + 63) / 64;
+    }
+    shared.firstSection.push_back(shared.sectionClass.size());
+    shared.firstWord.push_back(shared.domainWords);
+    shared.maskBegin.push_back(shared.maskWord.size());
+    std::map<std::tuple<int, int, int>, uint32_t> slots;
+    for (size_t section = 0; section < shared.sectionClass.size(); ++section) {
+        const ClassDetails& cls = *shared.sectionClass[section];
+        std::tuple<int, int, int> times(cls.dayMask, cls.startMinutes, cls.endMinutes);
+        shared.sectionSlot.push_back(slots.insert(std::make_pair(times, static_cast<uint32_t>(slots.size()))).first->second);
+    }
+
+    root.domains.assign(shared.domainWords, 0);
+    root.chosen.assign(subjects.size(), -1);
+    for (size_t section = 0; section < shared.sectionClass.size(); ++section) {
+        size_t subject = shared.sectionSubject[section];
+        size_t bit = section - shared.firstSection[subject];
+        root.domains[shared.firstWord[subject] + bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+
+    // 3. Pairwise compatibility, once: two sections clash if they share a day and their times overlap
+    const size_t sectionCount = shared.sectionClass.size();
+    shared.compatible.assign(sectionCount * shared.domainWords, 0);
+    for (size_t a = 0; a < sectionCount; ++a) {
+        const ClassDetails& first = *shared.sectionClass[a];
+        uint64_t* row = &shared.compatible[a * shared.domainWords];
+        for (size_t b = 0; b < sectionCount; ++b) {
+            size_t subject = shared.sectionSubject[b];
+            if (subject == shared.sectionSubject[a]) continue;
+            const ClassDetails& second = *shared.sectionClass[b];
+            bool clash = (first.dayMask & second.dayMask) && first.startMinutes < second.endMinutes &&
+                         second.startMinutes < first.endMinutes;
+            if (clash) continue;
+            size_t bit = b - shared.firstSection[subject];
+            row[shared.firstWord[subject] + bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+
+    // 4. Sections by the days they meet on, for the day-count bound
+    shared.within.assign(128 * shared.domainWords, 0);
+    for (size_t section = 0; section < sectionCount; ++section) {
+        size_t subject = shared.sectionSubject[section];
+        size_t bit = section - shared.firstSection[subject];
+        unsigned char days = shared.sectionClass[section]->dayMask;
+        for (int mask = 0; mask < 128; ++mask) {
+            if ((days & mask) == days) shared.within[mask * shared.domainWords + shared.firstWord[subject] + bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+
+    // 5. One root per set of days the combination meets on, fewest days first.
+    //    Every combination meets on exactly one such set, so no combination is
+    //    scored twice, and once the best kept are full a set too large to beat
+    //    them is cut at its root.
+    std::vector<std::pair<int, int> > daySets; // (day count, mask)
+    for (int mask = 1; mask < 128; ++mask) {
+        if ((mask & root.daysUsed) == root.daysUsed) daySets.push_back(std::make_pair(countBits(static_cast<uint64_t>(mask)), mask));
+    }
+    std::sort(daySets.begin(), daySets.end());
+    for (size_t k = daySets.size(); k-- > 0;) {
+        SearchState task = root;
+        task.days = static_cast<unsigned char>(daySets[k].second);
+        const uint64_t* inside = &shared.within[task.days * shared.domainWords];
+        for (size_t w = 0; w < shared.domainWords; ++w) task.domains[w] &= inside[w];
+        shared.queues[k % threadCount].tasks.push_back(task); // Each thread starts on its smallest sets
+        shared.pendingTasks++;
+        shared.queuedTasks++;
+    }
+
+    // 6. Search on every thread; the calling thread is worker 0
+    std::deque<SearchWorker> workers; // In place: a deque never moves its elements
+    for (unsigned i = 0; i < threadCount; ++i) workers.emplace_back(shared, i);
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadCount; ++i) threads.push_back(std::thread(&SearchWorker::run, &workers[i]));
+    workers[0].run();
+    for (size_t i = 0; i < threads.size(); ++i) threads[i].join();
+
+    for (size_t i = 0; i < workers.size(); ++i) {
+        result.pruned += workers[i].pruned();
+        result.complete += workers[i].complete();
+        result.steals += workers[i].steals();
+    }
+    result.nodes = shared.nodes.load();
+    result.exhaustive = !shared.stop.load();
+    return shared.best;
+}
+
+bool readSectionCandidatesCsv(const std::string& path, std::vector<TimetableSubject>& subjects,
+                              std::vector<ClassImportIssue>& issues) {
+    subjects.clear();
+    issues.clear();
+    MappedFile input;
+    if (!input.open(path)) return false;
+
+    std::unordered_map<std::string, size_t> subjectIndex;
+    CsvReader reader(input.data(), input.size());
+    std::vector<std::string> fields;
+    bool first = true;
+    while (reader.next_record(fields)) {
+        if (first) {
+            first = false;
+            std::string head = fields[0];
+            std::transform(head.begin(), head.end(), head.begin(), ::tolower);
+            if (head == "subject") continue; // Optional header row
+        }
+        ClassDetails cls;
+        const char* problem = parse_class_row(fields, cls); // From class_import.h
+        if (problem) {
+            ClassImportIssue issue;
+            issue.line = reader.line_number();
+            issue.message = problem;
+            issues.push_back(issue);
+            continue;
+        }
+        auto found = subjectIndex.find(cls.subject);
+        if (found == subjectIndex.end()) {
+            found = subjectIndex.insert(std::make_pair(cls.subject, subjects.size())).first;
+            subjects.push_back(TimetableSubject());
+            subjects.back().subject = cls.subject;
+        }
+        subjects[found->second].sections.push_back(cls);
+    }
+    return true;
+}
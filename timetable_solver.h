@@ -0,0 +1,94 @@
+#ifndef TIMETABLE_SOLVER_H
+#define TIMETABLE_SOLVER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "scheduler_core.h" // For ClassDetails
+#include "class_import.h"   // For ClassImportIssue
+
+// --- Timetable solver ---
+// Picks one section per subject so that no two chosen sections overlap each
+// other or any fixed class, and ranks the conflict-free combinations by the
+// preferences below (lower penalty is better).
+//
+// Section-vs-section conflicts are found once, up front, and stored as
+// compatibility bitsets: for each section, which sections of every other
+// subject it can be taken with. The search keeps each open subject's remaining
+// sections as a bitset too, so choosing a section prunes every other subject's
+// options with a few word ANDs (forward checking). The subject with the fewest
+// options left is branched on first, and an empty subject ends the branch.
+//
+// Every combination meets on exactly one set of days, so the search is split
+// into one root per day set, fewest days first. Below such a root only that
+// set's sections are open, and a combination counts only if it uses every one
+// of its days; a root that can't beat the combinations kept is cut at once.
+//
+// Busy time is a per-day minute bitset (fixed classes included). Candidates
+// touching a fixed class are dropped before the search, and the gaps in each
+// day give the idle-time part of a lower bound on a branch's penalty; a branch
+// is cut once that bound reaches the worst of the best combinations kept, or
+// once the open subjects can't all be given pairwise compatible sections.
+// Subtrees reached again by putting the same subjects in the same time slots
+// in another order are skipped if the first visit kept nothing.
+//
+// Branches are spread across threads with work stealing: each thread works
+// depth-first on its own deque and hands sibling branches to it while another
+// thread is idle; idle threads steal the oldest (largest) branch from a
+// victim's deque, and sleep on a condition variable while there is none. The
+// penalties returned do not depend on the thread count; when several
+// combinations tie with the last one kept, which of them are returned can.
+
+struct TimetableSubject {
+    std::string subject;
+    std::vector<ClassDetails> sections; // Alternatives; exactly one is chosen. Invalid times or no days: never chosen
+};
+
+struct TimetablePreferences {
+    int earliestStartMinutes; // Class minutes before this time of day count as early
+    int earlyMinuteWeight;    // Penalty per early class minute, per meeting
+    int idleMinuteWeight;     // Penalty per free minute between a day's first and last class
+    int dayWeight;            // Penalty per day with any class
+    size_t maxResults;        // Best combinations kept
+    unsigned threads;         // 0 = one per hardware thread
+    unsigned long long nodeLimit; // Stop after this many search nodes and return the best so far; 0 = no limit
+
+    TimetablePreferences()
+        : earliestStartMinutes(9 * 60), earlyMinuteWeight(2), idleMinuteWeight(1), dayWeight(60),
+          maxResults(10), threads(0), nodeLimit(0) {}
+};
+
+struct TimetableSolution {
+    std::vector<size_t> sections; // sections[i] indexes subjects[i].sections
+    int penalty;
+    int earlyMinutes; // The three terms of the penalty, fixed classes included
+    int idleMinutes;
+    int days;
+};
+
+struct TimetableSolveStats {
+    unsigned long long nodes;     // Partial combinations visited
+    unsigned long long pruned;    // Branches cut by propagation or the bound
+    unsigned long long complete;  // Conflict-free combinations reached
+    unsigned long long steals;    // Branches taken from another thread's deque
+    unsigned threads;
+    bool exhaustive;              // False if nodeLimit stopped the search early
+
+    TimetableSolveStats() : nodes(0), pruned(0), complete(0), steals(0), threads(0), exhaustive(true) {}
+};
+
+// Best combinations first (by penalty, then section indices); empty if no
+// conflict-free combination exists.
+std::vector<TimetableSolution> solveTimetable(const std::vector<TimetableSubject>& subjects,
+                                              const std::vector<ClassDetails>& fixedClasses,
+                                              const TimetablePreferences& preferences,
+                                              TimetableSolveStats* stats = nullptr);
+
+// Reads candidate sections from a CSV file in the import-classes format
+// (subject,days,start,end[,venue]); rows with the same subject are that
+// subject's sections, and subjects keep the order they first appear in.
+// Rejected rows are reported in `issues`. Returns false only if `path` can't be read.
+bool readSectionCandidatesCsv(const std::string& path, std::vector<TimetableSubject>& subjects,
+                              std::vector<ClassImportIssue>& issues);
+
+#endif // TIMETABLE_SOLVER_H
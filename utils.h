@@ -1,29 +1,33 @@
-#ifndef UTILS_H
-#define UTILS_H
-
-#include <string>
-#include <vector>
-#include <limits>
-#include <algorithm>
-#include <iomanip>
-#include <chrono>
-#include <ctime>
-#include <sstream>
-#include <regex>
-#include <set>
-#include <iostream> // For std::cout, std::cin, std::cerr
-#include <map>     // For isValidDay
-
-// Function Declarations
-std::string getCurrentDateYYYYMMDD();
-std::string getCurrentDayOfWeek();
-// std::string urgencyToString(int urgency); // Declaration will be in scheduler_planner.h
-bool isValidDay(const std::string& day);
-bool parseDaysOfWeek(const std::string& daysInput, std::vector<std::string>& daysOfWeek); // Uses isValidDay, std::cout
-bool isValidTimeFormat(const std::string& timeStr); // Uses std::cout
-int timeToMinutes(const std::string& timeStr);      // Uses isValidTimeFormat
-void clear_input_buffer();                          // Uses std::cin
-std::string getCurrentTimestamp();                  // For Flashcards and Notes
-std::string get_string_input(const std::string& prompt); // Uses std::cout, std::cin
-
-#endif // UTILS_H
+#ifndef UTILS_H
+#define UTILS_H
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <iomanip>
+#include <chrono>
+#include <ctime>
+#include <sstream>
+#include <cctype>  // For the hand-written time parser
+#include <set>
+#include <iostream> // For std::cout, std::cin, std::cerr
+#include "civil_date.h" // For CivilDate, INVALID_DAY_NUMBER
+
+// Function Declarations
+std::string getCurrentDayOfWeek();
+// std::string urgencyToString(int urgency); // Declaration will be in scheduler_planner.h
+int getCurrentDayIndex();                           // 0=Sun .. 6=Sat (tm_wday), -1 on error
+// Weekdays are stored as a 7-bit mask: bit d is set for tm_wday d (bit 0 = Sunday).
+const unsigned char ALL_DAYS_MASK = 0x7F;
+int dayTokenToIndex(const char* token, size_t length); // "M"/"Mon"/"MONDAY"/"th"... -> 0..6, -1 if unknown; no allocation
+const char* dayIndexToName(int dayIndex);           // 0..6 -> "Sun".."Sat"
+bool parseDaysOfWeek(const std::string& daysInput, unsigned char& dayMask); // Comma-separated tokens -> mask; false if any token is invalid
+std::string dayMaskToString(unsigned char dayMask); // e.g. "Mon,Wed,Fri"
+int countDays(unsigned char dayMask);
+int parseTimeToMinutes(const char* timeStr, size_t length); // "HH:MM AM/PM" -> minutes since midnight, -1 if invalid; no allocation
+int timeToMinutes(const std::string& timeStr);      // Uses parseTimeToMinutes
+std::string minutesToTimeString(int minutesSinceMidnight); // Inverse of timeToMinutes, e.g. 570 -> "09:30 AM"; only for display and .dat files
+std::string getCurrentTimestamp();                  // For Flashcards and Notes
+
+#endif // UTILS_H